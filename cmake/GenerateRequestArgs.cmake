@@ -0,0 +1,146 @@
+# Generates a `RequestArgs` struct and parser for every request type from the `@requestField` annotations collected in
+# docs/generated/protocol.json. Nested fields (`parent.child`) are left to the handler, which gets their parent object.
+# REQUEST_TYPES is a comma separated list which limits generation to the request types whose handlers use the parsers,
+# as the header is compiled by every handler. Every request type is generated if it is empty. Like the `Validate*`
+# helpers, empty strings, objects and arrays are rejected, except for the `<requestType>.<field>` entries in the comma
+# separated ALLOW_EMPTY list.
+#
+# The output is only replaced when its contents change, so dependent sources are not rebuilt for nothing. STAMP is touched
+# on every run instead, to give the build an output that is newer than its inputs.
+#
+# Requires CMake 3.19 for string(JSON).
+#
+# Usage: cmake -DPROTOCOL_JSON=<protocol.json> -DOUTPUT=<header> -DSTAMP=<stamp> [-DREQUEST_TYPES=<type,...>]
+# [-DALLOW_EMPTY=<type.field,...>] -P GenerateRequestArgs.cmake
+
+if(CMAKE_VERSION VERSION_LESS 3.19)
+  message(FATAL_ERROR "Generating request argument parsers requires CMake 3.19 or newer, found ${CMAKE_VERSION}.")
+endif()
+cmake_policy(VERSION 3.19)
+
+file(READ "${PROTOCOL_JSON}" protocol)
+string(REPLACE "," ";" requestTypes "${REQUEST_TYPES}")
+string(REPLACE "," ";" allowEmptyFields "${ALLOW_EMPTY}")
+
+set(header
+    "// Generated from docs/generated/protocol.json by cmake/GenerateRequestArgs.cmake. Do not edit.\n\n#pragma once\n\nnamespace RequestArgs {\n"
+)
+
+string(JSON requestCount LENGTH "${protocol}" requests)
+math(EXPR lastRequest "${requestCount} - 1")
+foreach(requestIndex RANGE ${lastRequest})
+  string(JSON request GET "${protocol}" requests ${requestIndex})
+  string(JSON requestType GET "${request}" requestType)
+  if(requestTypes AND NOT requestType IN_LIST requestTypes)
+    continue()
+  endif()
+  string(JSON fieldCount LENGTH "${request}" requestFields)
+
+  set(members "")
+  set(fields "")
+  set(decodes "")
+  set(index 0)
+  if(fieldCount GREATER 0)
+    math(EXPR lastField "${fieldCount} - 1")
+    foreach(fieldIndex RANGE ${lastField})
+      string(JSON field GET "${request}" requestFields ${fieldIndex})
+      string(JSON valueName GET "${field}" valueName)
+      if(NOT valueName MATCHES "^[A-Za-z_][A-Za-z0-9_]*$")
+        continue()
+      endif()
+      string(JSON valueType GET "${field}" valueType)
+      string(JSON valueOptional GET "${field}" valueOptional)
+      string(JSON valueRestrictions GET "${field}" valueRestrictions)
+
+      if(valueType STREQUAL "String")
+        set(fieldType String)
+        set(memberType "std::string")
+        set(memberInit "")
+      elseif(valueType STREQUAL "Number")
+        set(fieldType Number)
+        set(memberType "double")
+        set(memberInit " = 0")
+      elseif(valueType STREQUAL "Boolean")
+        set(fieldType Boolean)
+        set(memberType "bool")
+        set(memberInit " = false")
+      elseif(valueType STREQUAL "Object")
+        set(fieldType Object)
+        set(memberType "const json *")
+        set(memberInit " = nullptr")
+      elseif(valueType MATCHES "^Array")
+        set(fieldType Array)
+        set(memberType "const json *")
+        set(memberInit " = nullptr")
+      else()
+        set(fieldType Any)
+        set(memberType "const json *")
+        set(memberInit " = nullptr")
+      endif()
+
+      if(valueOptional AND NOT memberType STREQUAL "const json *")
+        set(memberType "std::optional<${memberType}>")
+        set(memberInit "")
+      endif()
+
+      if(valueOptional)
+        set(optional true)
+      else()
+        set(optional false)
+      endif()
+
+      if("${requestType}.${valueName}" IN_LIST allowEmptyFields)
+        set(allowEmpty true)
+      else()
+        set(allowEmpty false)
+      endif()
+
+      set(minValue -INFINITY)
+      set(maxValue INFINITY)
+      if(valueRestrictions MATCHES ">= *(-?[0-9.]+)")
+        set(minValue ${CMAKE_MATCH_1})
+      endif()
+      if(valueRestrictions MATCHES "<= *(-?[0-9.]+)")
+        set(maxValue ${CMAKE_MATCH_1})
+      endif()
+
+      if(memberType MATCHES "\\*$")
+        string(APPEND members "\t\t${memberType}${valueName}${memberInit};\n")
+      else()
+        string(APPEND members "\t\t${memberType} ${valueName}${memberInit};\n")
+      endif()
+      string(APPEND fields "\t\t\t\t{\"${valueName}\", FieldType::${fieldType}, ${optional}, ${allowEmpty}, ${minValue}, ${maxValue}},\n")
+      string(APPEND decodes "\t\t\tDecode(values[${index}], ${valueName});\n")
+      math(EXPR index "${index} + 1")
+    endforeach()
+  endif()
+
+  if(index EQUAL 0)
+    continue()
+  endif()
+
+  string(
+    APPEND
+    header
+    "\tstruct ${requestType} {\n"
+    "${members}\n"
+    "\t\tbool Parse(const Request &request, RequestStatus::RequestStatus &statusCode, std::string &comment)\n"
+    "\t\t{\n"
+    "\t\t\tstatic const Field fields[] = {\n"
+    "${fields}"
+    "\t\t\t};\n"
+    "\t\t\tconst json *values[${index}];\n"
+    "\t\t\tif (!CollectFields(request, fields, ${index}, values, statusCode, comment))\n"
+    "\t\t\t\treturn false;\n\n"
+    "${decodes}"
+    "\t\t\treturn true;\n"
+    "\t\t}\n"
+    "\t};\n\n")
+endforeach()
+
+string(APPEND header "}\n")
+
+file(WRITE "${OUTPUT}.tmp" "${header}")
+configure_file("${OUTPUT}.tmp" "${OUTPUT}" COPYONLY)
+file(REMOVE "${OUTPUT}.tmp")
+file(TOUCH "${STAMP}")
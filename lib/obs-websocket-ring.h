@@ -0,0 +1,291 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2022 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#ifndef _OBS_WEBSOCKET_RING_H
+#define _OBS_WEBSOCKET_RING_H
+
+/*
+ * Reader for the obs-websocket shared memory event ring, enabled with the `EventRingName` config option.
+ *
+ * obs-websocket is the only writer. Each record holds one event, serialized exactly like an `Event` (op 5) Json message
+ * sent over WebSocket. Readers never block the writer. A reader which falls more than a full ring behind loses events,
+ * and is told so by `obs_websocket_ring_read()`.
+ *
+ * Usage:
+ *	struct obs_websocket_ring_reader reader;
+ *	if (obs_websocket_ring_open(&reader, "obs-websocket-events")) {
+ *		while (running) {
+ *			int ret = obs_websocket_ring_read(&reader, buf, sizeof(buf), &sequence, &length);
+ *			if (ret == 0)
+ *				obs_websocket_ring_wait(&reader, 100);
+ *			else if (ret > 0)
+ *				handle_event(buf, length);
+ *		}
+ *		obs_websocket_ring_close(&reader);
+ *	}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#define OBS_WEBSOCKET_RING_MAGIC 0x5253574F // "OWSR"
+#define OBS_WEBSOCKET_RING_VERSION 1
+
+#define OBS_WEBSOCKET_RING_RECORD_PADDING (1 << 0) // Filler up to the end of the data area. Not an event.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Lives at the start of the mapping, the data area follows directly after it
+struct obs_websocket_ring_header {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t capacity;    // Size of the data area in bytes, a multiple of 16
+	uint64_t write_pos;   // Total bytes written. Every record before this position is complete.
+	uint64_t reserve_pos; // Total bytes the writer has claimed. Data older than `reserve_pos - capacity` may be torn.
+	uint64_t sequence;    // Sequence number of the newest record
+	uint32_t futex;       // Incremented after every record
+	uint32_t waiters;     // Readers currently sleeping on `futex`
+	uint8_t reserved[16];
+};
+
+// Records start on 16 byte boundaries. Positions are monotonic, the offset into the data area is `pos % capacity`.
+struct obs_websocket_ring_record {
+	uint64_t sequence;
+	uint32_t length; // Payload bytes following this header
+	uint32_t flags;
+};
+
+struct obs_websocket_ring_reader {
+	struct obs_websocket_ring_header *header;
+	uint8_t *data;
+	size_t mapping_size;
+	uint64_t read_pos;
+#ifdef _WIN32
+	HANDLE mapping;
+#endif
+};
+
+/* ==================== INTERNAL DEFINITIONS ==================== */
+
+#define OBS_WEBSOCKET_RING_ALIGN(size) (((uint64_t)(size) + 15) & ~(uint64_t)15)
+
+#ifdef _MSC_VER
+#define obs_websocket_ring_load64(ptr) ((uint64_t)InterlockedCompareExchange64((volatile LONG64 *)(ptr), 0, 0))
+#define obs_websocket_ring_store64(ptr, value) InterlockedExchange64((volatile LONG64 *)(ptr), (LONG64)(value))
+#define obs_websocket_ring_load32(ptr) ((uint32_t)InterlockedCompareExchange((volatile LONG *)(ptr), 0, 0))
+#define obs_websocket_ring_add32(ptr, value) InterlockedExchangeAdd((volatile LONG *)(ptr), (LONG)(value))
+#define obs_websocket_ring_fence() MemoryBarrier()
+#else
+#define obs_websocket_ring_load64(ptr) __atomic_load_n((ptr), __ATOMIC_SEQ_CST)
+#define obs_websocket_ring_store64(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_SEQ_CST)
+#define obs_websocket_ring_load32(ptr) __atomic_load_n((ptr), __ATOMIC_SEQ_CST)
+#define obs_websocket_ring_add32(ptr, value) __atomic_fetch_add((ptr), (value), __ATOMIC_SEQ_CST)
+#define obs_websocket_ring_fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+// Platform name of the shared memory object for a configured ring name
+static inline void obs_websocket_ring_object_name(const char *name, char *buf, size_t buf_size)
+{
+#ifdef _WIN32
+	snprintf(buf, buf_size, "Local\\%s", name);
+#else
+	snprintf(buf, buf_size, "/%s", name);
+#endif
+}
+
+/* ==================== READER API FUNCTIONS ==================== */
+
+// Maps an existing ring. Reading starts at the newest record. Returns false if the ring does not exist (yet).
+static inline bool obs_websocket_ring_open(struct obs_websocket_ring_reader *reader, const char *name)
+{
+	char object_name[256];
+	obs_websocket_ring_object_name(name, object_name, sizeof(object_name));
+	memset(reader, 0, sizeof(*reader));
+
+#ifdef _WIN32
+	reader->mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, object_name);
+	if (!reader->mapping)
+		return false;
+
+	void *mapping = MapViewOfFile(reader->mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+	MEMORY_BASIC_INFORMATION info;
+	if (!mapping || !VirtualQuery(mapping, &info, sizeof(info))) {
+		if (mapping)
+			UnmapViewOfFile(mapping);
+		CloseHandle(reader->mapping);
+		return false;
+	}
+	reader->mapping_size = info.RegionSize;
+#else
+	int fd = shm_open(object_name, O_RDWR, 0);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(struct obs_websocket_ring_header)) {
+		close(fd);
+		return false;
+	}
+	reader->mapping_size = (size_t)st.st_size;
+
+	void *mapping = mmap(NULL, reader->mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED)
+		return false;
+#endif
+
+	reader->header = (struct obs_websocket_ring_header *)mapping;
+	reader->data = (uint8_t *)mapping + sizeof(struct obs_websocket_ring_header);
+
+	if (obs_websocket_ring_load32(&reader->header->magic) != OBS_WEBSOCKET_RING_MAGIC ||
+	    reader->header->version != OBS_WEBSOCKET_RING_VERSION ||
+	    sizeof(struct obs_websocket_ring_header) + reader->header->capacity > reader->mapping_size) {
+#ifdef _WIN32
+		UnmapViewOfFile(mapping);
+		CloseHandle(reader->mapping);
+#else
+		munmap(mapping, reader->mapping_size);
+#endif
+		reader->header = NULL;
+		return false;
+	}
+
+	reader->read_pos = obs_websocket_ring_load64(&reader->header->write_pos);
+	return true;
+}
+
+static inline void obs_websocket_ring_close(struct obs_websocket_ring_reader *reader)
+{
+	if (!reader->header)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(reader->header);
+	CloseHandle(reader->mapping);
+#else
+	munmap(reader->header, reader->mapping_size);
+#endif
+	reader->header = NULL;
+}
+
+/*
+ * Copies the next event into `buf`. Returns:
+ *	1 if an event was read
+ *	0 if there is no new event
+ *	-1 if the writer overtook the reader, which has been moved to the newest record. Events were lost.
+ *	-2 if `buf` is too small. `length` is set to the required size and the event is not consumed.
+ */
+static inline int obs_websocket_ring_read(struct obs_websocket_ring_reader *reader, char *buf, size_t buf_size,
+					  uint64_t *sequence, size_t *length)
+{
+	struct obs_websocket_ring_header *header = reader->header;
+	uint64_t capacity = header->capacity;
+
+	while (true) {
+		uint64_t write_pos = obs_websocket_ring_load64(&header->write_pos);
+		if (reader->read_pos == write_pos)
+			return 0;
+
+		if (write_pos - reader->read_pos > capacity) {
+			reader->read_pos = write_pos;
+			return -1;
+		}
+
+		struct obs_websocket_ring_record record;
+		uint64_t offset = reader->read_pos % capacity;
+		memcpy(&record, reader->data + offset, sizeof(record));
+
+		bool is_event = !(record.flags & OBS_WEBSOCKET_RING_RECORD_PADDING);
+		bool fits = record.length <= buf_size;
+		if (is_event && fits && offset + sizeof(record) + record.length <= capacity)
+			memcpy(buf, reader->data + offset + sizeof(record), record.length);
+
+		// Like a seqlock, only trust what was copied if the writer has not claimed its space in the meantime
+		obs_websocket_ring_fence();
+		if (obs_websocket_ring_load64(&header->reserve_pos) - reader->read_pos > capacity) {
+			reader->read_pos = obs_websocket_ring_load64(&header->write_pos);
+			return -1;
+		}
+
+		if (is_event && !fits) {
+			*length = record.length;
+			return -2;
+		}
+
+		reader->read_pos += OBS_WEBSOCKET_RING_ALIGN(sizeof(record) + record.length);
+		if (!is_event)
+			continue;
+
+		*sequence = record.sequence;
+		*length = record.length;
+		return 1;
+	}
+}
+
+// Sleeps until a new record may be available or `timeout_ms` passes. Uses a futex on Linux and polls elsewhere.
+static inline void obs_websocket_ring_wait(struct obs_websocket_ring_reader *reader, uint32_t timeout_ms)
+{
+	struct obs_websocket_ring_header *header = reader->header;
+
+#ifdef __linux__
+	uint32_t futex = obs_websocket_ring_load32(&header->futex);
+	obs_websocket_ring_add32(&header->waiters, 1);
+	if (obs_websocket_ring_load64(&header->write_pos) == reader->read_pos) {
+		struct timespec timeout = {(time_t)(timeout_ms / 1000), (long)(timeout_ms % 1000) * 1000000};
+		syscall(SYS_futex, &header->futex, FUTEX_WAIT, futex, &timeout, NULL, 0);
+	}
+	obs_websocket_ring_add32(&header->waiters, -1);
+#else
+	for (uint32_t waited = 0; waited < timeout_ms; waited++) {
+		if (obs_websocket_ring_load64(&header->write_pos) != reader->read_pos)
+			return;
+#ifdef _WIN32
+		Sleep(1);
+#else
+		usleep(1000);
+#endif
+	}
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -20,6 +20,7 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <obs-frontend-api.h>
 
 #include "Config.h"
+#include "eventhandler/types/EventSubscription.h"
 #include "utils/Crypto.h"
 #include "utils/Platform.h"
 
@@ -31,6 +32,23 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #define PARAM_ALERTS "AlertsEnabled"
 #define PARAM_AUTHREQUIRED "AuthRequired"
 #define PARAM_PASSWORD "ServerPassword"
+#define PARAM_IOTHREADS "ServerIoThreads"
+#define PARAM_OUTBOUNDHIGHWATERMARK "OutboundQueueHighWaterMark"
+#define PARAM_SLOWCONSUMERPOLICY "SlowConsumerPolicy"
+#define PARAM_COMPRESSIONENABLED "CompressionEnabled"
+#define PARAM_COMPRESSIONMINSIZE "CompressionMinSize"
+#define PARAM_COMPRESSIONLEVEL "CompressionLevel"
+#define PARAM_LOCALSOCKETPATH "LocalSocketPath"
+#define PARAM_LOCALSOCKETPERMISSIONS "LocalSocketPermissions"
+#define PARAM_EVENTRINGNAME "EventRingName"
+#define PARAM_EVENTRINGSIZE "EventRingSize"
+#define PARAM_EVENTRINGSUBSCRIPTIONS "EventRingSubscriptions"
+#define PARAM_UDPEVENTSENABLED "UdpEventsEnabled"
+#define PARAM_UDPMAXDATAGRAMSIZE "UdpMaxDatagramSize"
+#define PARAM_EVENTRATELIMITS "EventRateLimits"
+#define PARAM_SCENECOLLECTIONEVENTMODE "SceneCollectionEventMode"
+#define PARAM_EVENTREPLAYBUFFERSIZE "EventReplayBufferSize"
+#define PARAM_SESSIONRESUMEGRACEPERIOD "SessionResumeGracePeriod"
 
 #define CMDLINE_WEBSOCKET_PORT "websocket_port"
 #define CMDLINE_WEBSOCKET_PASSWORD "websocket_password"
@@ -45,7 +63,24 @@ Config::Config() :
 	DebugEnabled(false),
 	AlertsEnabled(false),
 	AuthRequired(true),
-	ServerPassword("AmdoxRecorder")
+	ServerPassword("AmdoxRecorder"),
+	ServerIoThreads(0),
+	OutboundQueueHighWaterMark(8 * 1024 * 1024),
+	SlowConsumerPolicy(1),
+	CompressionEnabled(true),
+	CompressionMinSize(4096),
+	CompressionLevel(1),
+	LocalSocketPath(""),
+	LocalSocketPermissions(0600),
+	EventRingName(""),
+	EventRingSize(4 * 1024 * 1024),
+	EventRingSubscriptions(EventSubscription::InputVolumeMeters | EventSubscription::SceneItemTransformChanged),
+	UdpEventsEnabled(false),
+	UdpMaxDatagramSize(1400),
+	EventRateLimits(""),
+	SceneCollectionEventMode(0),
+	EventReplayBufferSize(1024 * 1024),
+	SessionResumeGracePeriod(0)
 {
 	SetDefaultsToGlobalStore();
 }
@@ -64,6 +99,39 @@ void Config::Load()
 	ServerPort = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_PORT);
 	AuthRequired = config_get_bool(obsConfig, CONFIG_SECTION_NAME, PARAM_AUTHREQUIRED);
 	ServerPassword = config_get_string(obsConfig, CONFIG_SECTION_NAME, PARAM_PASSWORD);
+	ServerIoThreads = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_IOTHREADS);
+	OutboundQueueHighWaterMark = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_OUTBOUNDHIGHWATERMARK);
+	// Drop (0), Coalesce (1) or Close (2)
+	uint64_t slowConsumerPolicy = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_SLOWCONSUMERPOLICY);
+	if (slowConsumerPolicy > 2) {
+		blog(LOG_WARNING, "[Config::Load] Ignoring invalid slow consumer policy %llu. Coalescing instead.",
+		     (unsigned long long)slowConsumerPolicy);
+		slowConsumerPolicy = 1;
+		config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_SLOWCONSUMERPOLICY, slowConsumerPolicy);
+	}
+	SlowConsumerPolicy = slowConsumerPolicy;
+	CompressionEnabled = config_get_bool(obsConfig, CONFIG_SECTION_NAME, PARAM_COMPRESSIONENABLED);
+	CompressionMinSize = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_COMPRESSIONMINSIZE);
+	CompressionLevel = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_COMPRESSIONLEVEL);
+	LocalSocketPath = config_get_string(obsConfig, CONFIG_SECTION_NAME, PARAM_LOCALSOCKETPATH);
+	LocalSocketPermissions = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_LOCALSOCKETPERMISSIONS);
+	EventRingName = config_get_string(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRINGNAME);
+	EventRingSize = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRINGSIZE);
+	EventRingSubscriptions = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRINGSUBSCRIPTIONS);
+	UdpEventsEnabled = config_get_bool(obsConfig, CONFIG_SECTION_NAME, PARAM_UDPEVENTSENABLED);
+	UdpMaxDatagramSize = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_UDPMAXDATAGRAMSIZE);
+	EventRateLimits = config_get_string(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRATELIMITS);
+	// All (0), Summary (1) or SummaryWithInventory (2)
+	uint64_t sceneCollectionEventMode = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_SCENECOLLECTIONEVENTMODE);
+	if (sceneCollectionEventMode > 2) {
+		blog(LOG_WARNING, "[Config::Load] Ignoring invalid scene collection event mode %llu. Sending all events instead.",
+		     (unsigned long long)sceneCollectionEventMode);
+		sceneCollectionEventMode = 0;
+		config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_SCENECOLLECTIONEVENTMODE, sceneCollectionEventMode);
+	}
+	SceneCollectionEventMode = sceneCollectionEventMode;
+	EventReplayBufferSize = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTREPLAYBUFFERSIZE);
+	SessionResumeGracePeriod = config_get_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_SESSIONRESUMEGRACEPERIOD);
 
 	// Set server password and save it to the config before processing overrides,
 	// so that there is always a true configured password regardless of if
@@ -128,6 +196,23 @@ void Config::Save()
 		config_set_bool(obsConfig, CONFIG_SECTION_NAME, PARAM_AUTHREQUIRED, AuthRequired);
 		config_set_string(obsConfig, CONFIG_SECTION_NAME, PARAM_PASSWORD, QT_TO_UTF8(ServerPassword));
 	}
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_IOTHREADS, ServerIoThreads);
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_OUTBOUNDHIGHWATERMARK, OutboundQueueHighWaterMark);
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_SLOWCONSUMERPOLICY, SlowConsumerPolicy);
+	config_set_bool(obsConfig, CONFIG_SECTION_NAME, PARAM_COMPRESSIONENABLED, CompressionEnabled);
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_COMPRESSIONMINSIZE, CompressionMinSize);
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_COMPRESSIONLEVEL, CompressionLevel);
+	config_set_string(obsConfig, CONFIG_SECTION_NAME, PARAM_LOCALSOCKETPATH, QT_TO_UTF8(LocalSocketPath));
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_LOCALSOCKETPERMISSIONS, LocalSocketPermissions);
+	config_set_string(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRINGNAME, QT_TO_UTF8(EventRingName));
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRINGSIZE, EventRingSize);
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRINGSUBSCRIPTIONS, EventRingSubscriptions);
+	config_set_bool(obsConfig, CONFIG_SECTION_NAME, PARAM_UDPEVENTSENABLED, UdpEventsEnabled);
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_UDPMAXDATAGRAMSIZE, UdpMaxDatagramSize);
+	config_set_string(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRATELIMITS, QT_TO_UTF8(EventRateLimits));
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_SCENECOLLECTIONEVENTMODE, SceneCollectionEventMode);
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTREPLAYBUFFERSIZE, EventReplayBufferSize);
+	config_set_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_SESSIONRESUMEGRACEPERIOD, SessionResumeGracePeriod);
 
 	config_save(obsConfig);
 }
@@ -146,6 +231,23 @@ void Config::SetDefaultsToGlobalStore()
 	config_set_default_bool(obsConfig, CONFIG_SECTION_NAME, PARAM_ALERTS, AlertsEnabled);
 	config_set_default_bool(obsConfig, CONFIG_SECTION_NAME, PARAM_AUTHREQUIRED, AuthRequired);
 	config_set_default_string(obsConfig, CONFIG_SECTION_NAME, PARAM_PASSWORD, QT_TO_UTF8(ServerPassword));
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_IOTHREADS, ServerIoThreads);
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_OUTBOUNDHIGHWATERMARK, OutboundQueueHighWaterMark);
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_SLOWCONSUMERPOLICY, SlowConsumerPolicy);
+	config_set_default_bool(obsConfig, CONFIG_SECTION_NAME, PARAM_COMPRESSIONENABLED, CompressionEnabled);
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_COMPRESSIONMINSIZE, CompressionMinSize);
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_COMPRESSIONLEVEL, CompressionLevel);
+	config_set_default_string(obsConfig, CONFIG_SECTION_NAME, PARAM_LOCALSOCKETPATH, QT_TO_UTF8(LocalSocketPath));
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_LOCALSOCKETPERMISSIONS, LocalSocketPermissions);
+	config_set_default_string(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRINGNAME, QT_TO_UTF8(EventRingName));
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRINGSIZE, EventRingSize);
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRINGSUBSCRIPTIONS, EventRingSubscriptions);
+	config_set_default_bool(obsConfig, CONFIG_SECTION_NAME, PARAM_UDPEVENTSENABLED, UdpEventsEnabled);
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_UDPMAXDATAGRAMSIZE, UdpMaxDatagramSize);
+	config_set_default_string(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTRATELIMITS, QT_TO_UTF8(EventRateLimits));
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_SCENECOLLECTIONEVENTMODE, SceneCollectionEventMode);
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_EVENTREPLAYBUFFERSIZE, EventReplayBufferSize);
+	config_set_default_uint(obsConfig, CONFIG_SECTION_NAME, PARAM_SESSIONRESUMEGRACEPERIOD, SessionResumeGracePeriod);
 }
 
 config_t* Config::GetConfigStore()
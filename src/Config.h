@@ -43,4 +43,21 @@ struct Config {
 	std::atomic<bool> AlertsEnabled;
 	std::atomic<bool> AuthRequired;
 	QString ServerPassword;
+	std::atomic<uint32_t> ServerIoThreads;
+	std::atomic<uint64_t> OutboundQueueHighWaterMark;
+	std::atomic<uint8_t> SlowConsumerPolicy;
+	std::atomic<bool> CompressionEnabled;
+	std::atomic<uint32_t> CompressionMinSize;
+	std::atomic<uint8_t> CompressionLevel;
+	QString LocalSocketPath;
+	std::atomic<uint32_t> LocalSocketPermissions;
+	QString EventRingName;
+	std::atomic<uint64_t> EventRingSize;
+	std::atomic<uint64_t> EventRingSubscriptions;
+	std::atomic<bool> UdpEventsEnabled;
+	std::atomic<uint32_t> UdpMaxDatagramSize;
+	QString EventRateLimits;
+	std::atomic<uint8_t> SceneCollectionEventMode;
+	std::atomic<uint64_t> EventReplayBufferSize;
+	std::atomic<uint32_t> SessionResumeGracePeriod;
 };
@@ -17,14 +17,25 @@ You should have received a copy of the GNU General Public License along
 with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
+#include <algorithm>
+
 #include "EventHandler.h"
+#include "../Config.h"
+
+// Per-object events which are replaced by `SceneCollectionLoaded` while the scene collection changes
+static const uint64_t SceneCollectionSuppressedSubscriptions =
+	EventSubscription::Scenes | EventSubscription::Inputs | EventSubscription::Transitions | EventSubscription::Filters |
+	EventSubscription::SceneItems | EventSubscription::MediaInputs | EventSubscription::InputActiveStateChanged |
+	EventSubscription::InputShowStateChanged | EventSubscription::SceneItemTransformChanged;
 
 EventHandler::EventHandler()
 	: _obsLoaded(false),
-	  _inputVolumeMetersRef(0),
-	  _inputActiveStateChangedRef(0),
-	  _inputShowStateChangedRef(0),
-	  _sceneItemTransformChangedRef(0)
+	  _subscriptionRefs(),
+	  _subscriptionMask(0),
+	  _suppressedSubscriptions(0),
+	  _sceneCollectionEventMode(All),
+	  _connectedSourceSignals(0),
+	  _hotkeyIndexDirty(true)
 {
 	blog_debug("[EventHandler::EventHandler] Setting up...");
 
@@ -36,6 +47,9 @@ EventHandler::EventHandler()
 		signal_handler_connect(coreSignalHandler, "source_destroy", SourceDestroyedMultiHandler, this);
 		signal_handler_connect(coreSignalHandler, "source_remove", SourceRemovedMultiHandler, this);
 		signal_handler_connect(coreSignalHandler, "source_rename", SourceRenamedMultiHandler, this);
+		signal_handler_connect(coreSignalHandler, "hotkey_register", HotkeyIndexInvalidatedHandler, this);
+		signal_handler_connect(coreSignalHandler, "hotkey_unregister", HotkeyIndexInvalidatedHandler, this);
+		signal_handler_connect(coreSignalHandler, "hotkey_bindings_changed", HotkeyIndexInvalidatedHandler, this);
 	} else {
 		blog(LOG_ERROR, "[EventHandler::EventHandler] Unable to get libobs signal handler!");
 	}
@@ -49,12 +63,20 @@ EventHandler::~EventHandler()
 
 	obs_frontend_remove_event_callback(OnFrontendEvent, this);
 
+	// Removed unconditionally, as HasSubscribers() reports suppressed intents as unsubscribed. Removing a callback which
+	// was never added does nothing.
+	obs_remove_tick_callback(SceneItemTransformTick, this);
+	ClearPendingSceneItemTransforms();
+
 	signal_handler_t *coreSignalHandler = obs_get_signal_handler();
 	if (coreSignalHandler) {
 		signal_handler_disconnect(coreSignalHandler, "source_create", SourceCreatedMultiHandler, this);
 		signal_handler_disconnect(coreSignalHandler, "source_destroy", SourceDestroyedMultiHandler, this);
 		signal_handler_disconnect(coreSignalHandler, "source_remove", SourceRemovedMultiHandler, this);
 		signal_handler_disconnect(coreSignalHandler, "source_rename", SourceRenamedMultiHandler, this);
+		signal_handler_disconnect(coreSignalHandler, "hotkey_register", HotkeyIndexInvalidatedHandler, this);
+		signal_handler_disconnect(coreSignalHandler, "hotkey_unregister", HotkeyIndexInvalidatedHandler, this);
+		signal_handler_disconnect(coreSignalHandler, "hotkey_bindings_changed", HotkeyIndexInvalidatedHandler, this);
 	} else {
 		blog(LOG_ERROR, "[EventHandler::~EventHandler] Unable to get libobs signal handler!");
 	}
@@ -72,39 +94,71 @@ void EventHandler::SetObsLoadedCallback(EventHandler::ObsLoadedCallback cb)
 	_obsLoadedCallback = cb;
 }
 
-// Function to increment refcounts for high volume event subscriptions
+// Function to increment refcounts for event subscriptions. Bits going from 0 to 1 refs are added to the subscription mask.
 void EventHandler::ProcessSubscription(uint64_t eventSubscriptions)
 {
-	if ((eventSubscriptions & EventSubscription::InputVolumeMeters) != 0) {
-		if (_inputVolumeMetersRef.fetch_add(1) == 0) {
-			if (_inputVolumeMetersHandler)
-				blog(LOG_WARNING, "[EventHandler::ProcessSubscription] Input volume meter handler already exists!");
-			else
-				_inputVolumeMetersHandler = std::make_unique<Utils::Obs::VolumeMeter::Handler>(
-					std::bind(&EventHandler::HandleInputVolumeMeters, this, std::placeholders::_1));
-		}
+	std::unique_lock<std::mutex> lock(_subscriptionMutex);
+
+	uint64_t addedBits = 0;
+	for (size_t i = 0; i < _subscriptionRefs.size(); i++) {
+		uint64_t bit = 1ULL << i;
+		if ((eventSubscriptions & bit) == 0)
+			continue;
+		if (_subscriptionRefs[i]++ == 0)
+			addedBits |= bit;
+	}
+
+	if (!addedBits)
+		return;
+
+	_subscriptionMask.fetch_or(addedBits);
+
+	ConnectSignalCategories(addedBits);
+
+	if ((addedBits & EventSubscription::InputVolumeMeters) != 0) {
+		if (_inputVolumeMetersHandler)
+			blog(LOG_WARNING, "[EventHandler::ProcessSubscription] Input volume meter handler already exists!");
+		else
+			_inputVolumeMetersHandler = std::make_unique<Utils::Obs::VolumeMeter::Handler>(
+				std::bind(&EventHandler::HandleInputVolumeMeters, this, std::placeholders::_1));
 	}
-	if ((eventSubscriptions & EventSubscription::InputActiveStateChanged) != 0)
-		_inputActiveStateChangedRef++;
-	if ((eventSubscriptions & EventSubscription::InputShowStateChanged) != 0)
-		_inputShowStateChangedRef++;
-	if ((eventSubscriptions & EventSubscription::SceneItemTransformChanged) != 0)
-		_sceneItemTransformChangedRef++;
+
+	if ((addedBits & EventSubscription::SceneItemTransformChanged) != 0)
+		obs_add_tick_callback(SceneItemTransformTick, this);
 }
 
-// Function to decrement refcounts for high volume event subscriptions
+// Function to decrement refcounts for event subscriptions. Bits going from 1 to 0 refs are removed from the subscription mask.
 void EventHandler::ProcessUnsubscription(uint64_t eventSubscriptions)
 {
-	if ((eventSubscriptions & EventSubscription::InputVolumeMeters) != 0) {
-		if (_inputVolumeMetersRef.fetch_sub(1) == 1)
-			_inputVolumeMetersHandler.reset();
+	std::unique_lock<std::mutex> lock(_subscriptionMutex);
+
+	uint64_t removedBits = 0;
+	for (size_t i = 0; i < _subscriptionRefs.size(); i++) {
+		uint64_t bit = 1ULL << i;
+		if ((eventSubscriptions & bit) == 0)
+			continue;
+		if (!_subscriptionRefs[i]) {
+			blog(LOG_WARNING, "[EventHandler::ProcessUnsubscription] Subscription refcount for bit %zu is already zero!", i);
+			continue;
+		}
+		if (--_subscriptionRefs[i] == 0)
+			removedBits |= bit;
+	}
+
+	if (!removedBits)
+		return;
+
+	_subscriptionMask.fetch_and(~removedBits);
+
+	DisconnectSignalCategories(removedBits);
+
+	if ((removedBits & EventSubscription::InputVolumeMeters) != 0)
+		_inputVolumeMetersHandler.reset();
+
+	if ((removedBits & EventSubscription::SceneItemTransformChanged) != 0) {
+		obs_remove_tick_callback(SceneItemTransformTick, this);
+		ClearPendingSceneItemTransforms();
 	}
-	if ((eventSubscriptions & EventSubscription::InputActiveStateChanged) != 0)
-		_inputActiveStateChangedRef--;
-	if ((eventSubscriptions & EventSubscription::InputShowStateChanged) != 0)
-		_inputShowStateChangedRef--;
-	if ((eventSubscriptions & EventSubscription::SceneItemTransformChanged) != 0)
-		_sceneItemTransformChangedRef--;
 }
 
 // Function required in order to use default arguments
@@ -113,147 +167,569 @@ void EventHandler::BroadcastEvent(uint64_t requiredIntent, std::string eventType
 	if (!_broadcastCallback)
 		return;
 
-	_broadcastCallback(requiredIntent, eventType, eventData, rpcVersion);
+	_broadcastCallback(std::make_shared<Event>(requiredIntent, std::move(eventType), std::move(eventData), rpcVersion));
 }
 
-// Connect source signals for Inputs, Scenes, and Transitions. Filters are automatically connected.
-void EventHandler::ConnectSourceSignals(obs_source_t *source) // Applies to inputs and scenes
+const std::vector<EventHandler::SourceSignalCategory> EventHandler::_sourceSignalCategories = {
+	// Inputs
+	{EventSubscription::Inputs,
+	 OBS_SOURCE_TYPE_INPUT,
+	 {{"mute", HandleInputMuteStateChanged},
+	  {"volume", HandleInputVolumeChanged},
+	  {"audio_balance", HandleInputAudioBalanceChanged},
+	  {"audio_sync", HandleInputAudioSyncOffsetChanged},
+	  {"audio_mixers", HandleInputAudioTracksChanged},
+	  {"audio_monitoring", HandleInputAudioMonitorTypeChanged}}},
+	{EventSubscription::InputActiveStateChanged,
+	 OBS_SOURCE_TYPE_INPUT,
+	 {{"activate", HandleInputActiveStateChanged}, {"deactivate", HandleInputActiveStateChanged}}},
+	{EventSubscription::InputShowStateChanged,
+	 OBS_SOURCE_TYPE_INPUT,
+	 {{"show", HandleInputShowStateChanged}, {"hide", HandleInputShowStateChanged}}},
+	{EventSubscription::MediaInputs,
+	 OBS_SOURCE_TYPE_INPUT,
+	 {{"media_started", HandleMediaInputPlaybackStarted},
+	  {"media_ended", HandleMediaInputPlaybackEnded},
+	  {"media_pause", SourceMediaPauseMultiHandler},
+	  {"media_play", SourceMediaPlayMultiHandler},
+	  {"media_restart", SourceMediaRestartMultiHandler},
+	  {"media_stopped", SourceMediaStopMultiHandler},
+	  {"media_next", SourceMediaNextMultiHandler},
+	  {"media_previous", SourceMediaPreviousMultiHandler}}},
+
+	// Scenes
+	{EventSubscription::SceneItems,
+	 OBS_SOURCE_TYPE_SCENE,
+	 {{"item_add", HandleSceneItemCreated},
+	  {"item_remove", HandleSceneItemRemoved},
+	  {"reorder", HandleSceneItemListReindexed},
+	  {"item_visible", HandleSceneItemEnableStateChanged},
+	  {"item_locked", HandleSceneItemLockStateChanged},
+	  {"item_select", HandleSceneItemSelected}}},
+	{EventSubscription::SceneItemTransformChanged, OBS_SOURCE_TYPE_SCENE, {{"item_transform", HandleSceneItemTransformChanged}}},
+
+	// Inputs and Scenes. Filters of these sources are connected along with them.
+	{EventSubscription::Filters,
+	 OBS_SOURCE_TYPE_INPUT,
+	 {{"reorder_filters", HandleSourceFilterListReindexed},
+	  {"filter_add", FilterAddMultiHandler},
+	  {"filter_remove", FilterRemoveMultiHandler}}},
+	{EventSubscription::Filters,
+	 OBS_SOURCE_TYPE_SCENE,
+	 {{"reorder_filters", HandleSourceFilterListReindexed},
+	  {"filter_add", FilterAddMultiHandler},
+	  {"filter_remove", FilterRemoveMultiHandler}}},
+
+	// Filters
+	{EventSubscription::Filters,
+	 OBS_SOURCE_TYPE_FILTER,
+	 {{"enable", HandleSourceFilterEnableStateChanged}, {"rename", HandleSourceFilterNameChanged}}},
+
+	// Transitions
+	{EventSubscription::Transitions,
+	 OBS_SOURCE_TYPE_TRANSITION,
+	 {{"transition_start", HandleSceneTransitionStarted},
+	  {"transition_stop", HandleSceneTransitionEnded},
+	  {"transition_video_stop", HandleSceneTransitionVideoEnded}}},
+};
+
+// Adds a public input or scene to the registry and connects the signals of every currently subscribed category
+void EventHandler::RegisterSource(obs_source_t *source)
 {
 	if (!source || obs_source_removed(source))
 		return;
 
-	// Disconnect all existing signals from the source to prevent multiple connections
-	DisconnectSourceSignals(source);
+	obs_source_type sourceType = obs_source_get_type(source);
+	if (sourceType != OBS_SOURCE_TYPE_INPUT && sourceType != OBS_SOURCE_TYPE_SCENE)
+		return;
 
-	signal_handler_t *sh = obs_source_get_signal_handler(source);
+	std::unique_lock<std::mutex> lock(_sourceRegistryMutex);
+	if (!_sourceRegistry.insert(source).second)
+		return;
 
-	obs_source_type sourceType = obs_source_get_type(source);
+	IndexSourceName(source, obs_source_get_name(source));
+	uint64_t connectedSourceSignals = _connectedSourceSignals;
+	lock.unlock();
 
-	// Inputs
-	if (sourceType == OBS_SOURCE_TYPE_INPUT) {
-		signal_handler_connect(sh, "activate", HandleInputActiveStateChanged, this);
-		signal_handler_connect(sh, "deactivate", HandleInputActiveStateChanged, this);
-		signal_handler_connect(sh, "show", HandleInputShowStateChanged, this);
-		signal_handler_connect(sh, "hide", HandleInputShowStateChanged, this);
-		signal_handler_connect(sh, "mute", HandleInputMuteStateChanged, this);
-		signal_handler_connect(sh, "volume", HandleInputVolumeChanged, this);
-		signal_handler_connect(sh, "audio_balance", HandleInputAudioBalanceChanged, this);
-		signal_handler_connect(sh, "audio_sync", HandleInputAudioSyncOffsetChanged, this);
-		signal_handler_connect(sh, "audio_mixers", HandleInputAudioTracksChanged, this);
-		signal_handler_connect(sh, "audio_monitoring", HandleInputAudioMonitorTypeChanged, this);
-		signal_handler_connect(sh, "media_started", HandleMediaInputPlaybackStarted, this);
-		signal_handler_connect(sh, "media_ended", HandleMediaInputPlaybackEnded, this);
-		signal_handler_connect(sh, "media_pause", SourceMediaPauseMultiHandler, this);
-		signal_handler_connect(sh, "media_play", SourceMediaPlayMultiHandler, this);
-		signal_handler_connect(sh, "media_restart", SourceMediaRestartMultiHandler, this);
-		signal_handler_connect(sh, "media_stopped", SourceMediaStopMultiHandler, this);
-		signal_handler_connect(sh, "media_next", SourceMediaNextMultiHandler, this);
-		signal_handler_connect(sh, "media_previous", SourceMediaPreviousMultiHandler, this);
+	// Signal handlers are locked while their callbacks run, so libobs signal APIs are never called with the registry lock held
+	ConnectSourceSignals(source, connectedSourceSignals);
+
+	// Enumerating the scene takes its mutex, so this is kept out of the registry lock
+	if (sourceType == OBS_SOURCE_TYPE_SCENE)
+		ConnectSceneItemIndex(source);
+}
+
+void EventHandler::UnregisterSource(obs_source_t *source)
+{
+	if (!source)
+		return;
+
+	std::unique_lock<std::mutex> lock(_sourceRegistryMutex);
+	bool registered = _sourceRegistry.erase(source);
+	if (registered)
+		UnindexSourceName(source, obs_source_get_name(source));
+	uint64_t connectedSourceSignals = _connectedSourceSignals;
+	lock.unlock();
+
+	DisconnectSourceSignals(source, connectedSourceSignals);
+
+	if (registered && obs_source_get_type(source) == OBS_SOURCE_TYPE_SCENE)
+		DisconnectSceneItemIndex(source);
+}
+
+void EventHandler::IndexSourceName(obs_source_t *source, const std::string &sourceName)
+{
+	std::unique_lock<std::shared_mutex> lock(_sourceNameIndexMutex);
+	_sourceNameIndex[sourceName] = obs_source_get_weak_source(source);
+}
+
+// Only removes the entry if it still refers to `source`, as a newer source may have taken over the name
+void EventHandler::UnindexSourceName(obs_source_t *source, const std::string &sourceName)
+{
+	std::unique_lock<std::shared_mutex> lock(_sourceNameIndexMutex);
+	auto it = _sourceNameIndex.find(sourceName);
+	if (it != _sourceNameIndex.end() && obs_weak_source_references_source(it->second, source))
+		_sourceNameIndex.erase(it);
+}
+
+obs_source_t *EventHandler::GetSourceByName(const std::string &sourceName)
+{
+	obs_source_t *ret;
+	{
+		std::shared_lock<std::shared_mutex> lock(_sourceNameIndexMutex);
+		auto it = _sourceNameIndex.find(sourceName);
+		if (it == _sourceNameIndex.end())
+			return nullptr;
+
+		// Null if the source is being destroyed
+		ret = obs_weak_source_get_source(it->second);
 	}
 
-	// Scenes
-	if (sourceType == OBS_SOURCE_TYPE_SCENE) {
-		signal_handler_connect(sh, "item_add", HandleSceneItemCreated, this);
-		signal_handler_connect(sh, "item_remove", HandleSceneItemRemoved, this);
-		signal_handler_connect(sh, "reorder", HandleSceneItemListReindexed, this);
-		signal_handler_connect(sh, "item_visible", HandleSceneItemEnableStateChanged, this);
-		signal_handler_connect(sh, "item_locked", HandleSceneItemLockStateChanged, this);
-		signal_handler_connect(sh, "item_select", HandleSceneItemSelected, this);
-		signal_handler_connect(sh, "item_transform", HandleSceneItemTransformChanged, this);
+	// A rename may not have been signaled yet. Released outside of the lock, as it may destroy the source.
+	if (ret && sourceName != obs_source_get_name(ret)) {
+		obs_source_release(ret);
+		return nullptr;
 	}
 
-	// Scenes and Inputs
-	if (sourceType == OBS_SOURCE_TYPE_INPUT || sourceType == OBS_SOURCE_TYPE_SCENE) {
-		signal_handler_connect(sh, "reorder_filters", HandleSourceFilterListReindexed, this);
-		signal_handler_connect(sh, "filter_add", FilterAddMultiHandler, this);
-		signal_handler_connect(sh, "filter_remove", FilterRemoveMultiHandler, this);
-		auto enumFilters = [](obs_source_t *, obs_source_t *filter, void *param) {
-			auto eventHandler = static_cast<EventHandler *>(param);
-			eventHandler->ConnectSourceSignals(filter);
-		};
-		obs_source_enum_filters(source, enumFilters, this);
+	return ret;
+}
+
+void EventHandler::ConnectSceneItemIndex(obs_source_t *sceneSource)
+{
+	signal_handler_t *sh = obs_source_get_signal_handler(sceneSource);
+	signal_handler_connect(sh, "item_add", SceneItemIndexAddHandler, this);
+	signal_handler_connect(sh, "item_remove", SceneItemIndexRemoveHandler, this);
+	signal_handler_connect(sh, "reorder", SceneItemIndexRebuildHandler, this);
+	signal_handler_connect(sh, "refresh", SceneItemIndexRebuildHandler, this);
+
+	// Built after connecting, so no item added in between is missed
+	{
+		std::unique_lock<std::shared_mutex> lock(_sceneItemIndexMutex);
+		_sceneItemIndexes[sceneSource];
 	}
+	RebuildSceneItemIndex(sceneSource);
+}
 
-	// Transitions
-	if (sourceType == OBS_SOURCE_TYPE_TRANSITION) {
-		signal_handler_connect(sh, "transition_start", HandleSceneTransitionStarted, this);
-		signal_handler_connect(sh, "transition_stop", HandleSceneTransitionEnded, this);
-		signal_handler_connect(sh, "transition_video_stop", HandleSceneTransitionVideoEnded, this);
+void EventHandler::DisconnectSceneItemIndex(obs_source_t *sceneSource)
+{
+	signal_handler_t *sh = obs_source_get_signal_handler(sceneSource);
+	signal_handler_disconnect(sh, "item_add", SceneItemIndexAddHandler, this);
+	signal_handler_disconnect(sh, "item_remove", SceneItemIndexRemoveHandler, this);
+	signal_handler_disconnect(sh, "reorder", SceneItemIndexRebuildHandler, this);
+	signal_handler_disconnect(sh, "refresh", SceneItemIndexRebuildHandler, this);
+
+	// Item refs are released outside of the lock, as releasing them may destroy sources
+	SceneItemIndex index;
+	{
+		std::unique_lock<std::shared_mutex> lock(_sceneItemIndexMutex);
+		auto it = _sceneItemIndexes.find(sceneSource);
+		if (it == _sceneItemIndexes.end())
+			return;
+		index = std::move(it->second);
+		_sceneItemIndexes.erase(it);
 	}
+}
 
-	// Filters
-	if (sourceType == OBS_SOURCE_TYPE_FILTER) {
-		signal_handler_connect(sh, "enable", HandleSourceFilterEnableStateChanged, this);
-		signal_handler_connect(sh, "rename", HandleSourceFilterNameChanged, this);
+void EventHandler::RebuildSceneItemIndex(obs_source_t *sceneSource)
+{
+	obs_scene_t *scene = obs_scene_from_source(sceneSource);
+	if (!scene)
+		scene = obs_group_from_source(sceneSource);
+	if (!scene)
+		return;
+
+	auto cb = [](obs_scene_t *, obs_sceneitem_t *sceneItem, void *param) {
+		auto index = static_cast<SceneItemIndex *>(param);
+		int64_t sceneItemId = obs_sceneitem_get_id(sceneItem);
+		index->itemIdsBySource[obs_sceneitem_get_source(sceneItem)].push_back(sceneItemId);
+		index->itemsById[sceneItemId] = sceneItem;
+		return true;
+	};
+
+	// Items may be added or removed while enumerating, which would be overwritten by a stale enumeration. In that case the
+	// scene is enumerated again.
+	while (true) {
+		uint64_t generation;
+		{
+			std::shared_lock<std::shared_mutex> lock(_sceneItemIndexMutex);
+			auto it = _sceneItemIndexes.find(sceneSource);
+			if (it == _sceneItemIndexes.end())
+				return;
+			generation = it->second.generation;
+		}
+
+		SceneItemIndex index;
+		obs_scene_enum_items(scene, cb, &index);
+
+		// The previous index is swapped into `index`, and released once the lock is gone
+		std::unique_lock<std::shared_mutex> lock(_sceneItemIndexMutex);
+		auto it = _sceneItemIndexes.find(sceneSource);
+		if (it == _sceneItemIndexes.end())
+			return;
+		if (it->second.generation != generation)
+			continue;
+		index.generation = generation + 1;
+		std::swap(it->second, index);
+		lock.unlock();
+		return;
 	}
 }
 
-// Disconnect source signals for Inputs, Scenes, and Transitions. Filters are automatically disconnected.
-void EventHandler::DisconnectSourceSignals(obs_source_t *source)
+void EventHandler::SceneItemIndexAddHandler(void *param, calldata_t *data)
 {
-	if (!source)
+	auto eventHandler = static_cast<EventHandler *>(param);
+
+	obs_scene_t *scene = GetCalldataPointer<obs_scene_t>(data, "scene");
+	obs_sceneitem_t *sceneItem = GetCalldataPointer<obs_sceneitem_t>(data, "item");
+	if (!scene || !sceneItem)
 		return;
 
-	signal_handler_t *sh = obs_source_get_signal_handler(source);
+	// New items are always added on top. A ref replaced by this one is released once the lock is gone.
+	OBSSceneItem ref = sceneItem;
+	int64_t sceneItemId = obs_sceneitem_get_id(sceneItem);
+	std::unique_lock<std::shared_mutex> lock(eventHandler->_sceneItemIndexMutex);
+	auto it = eventHandler->_sceneItemIndexes.find(obs_scene_get_source(scene));
+	if (it == eventHandler->_sceneItemIndexes.end())
+		return;
 
-	obs_source_type sourceType = obs_source_get_type(source);
+	it->second.itemIdsBySource[obs_sceneitem_get_source(sceneItem)].push_back(sceneItemId);
+	std::swap(it->second.itemsById[sceneItemId], ref);
+	it->second.generation++;
+	lock.unlock();
+}
 
-	// Inputs
-	if (sourceType == OBS_SOURCE_TYPE_INPUT) {
-		signal_handler_disconnect(sh, "activate", HandleInputActiveStateChanged, this);
-		signal_handler_disconnect(sh, "deactivate", HandleInputActiveStateChanged, this);
-		signal_handler_disconnect(sh, "show", HandleInputShowStateChanged, this);
-		signal_handler_disconnect(sh, "hide", HandleInputShowStateChanged, this);
-		signal_handler_disconnect(sh, "mute", HandleInputMuteStateChanged, this);
-		signal_handler_disconnect(sh, "volume", HandleInputVolumeChanged, this);
-		signal_handler_disconnect(sh, "audio_balance", HandleInputAudioBalanceChanged, this);
-		signal_handler_disconnect(sh, "audio_sync", HandleInputAudioSyncOffsetChanged, this);
-		signal_handler_disconnect(sh, "audio_mixers", HandleInputAudioTracksChanged, this);
-		signal_handler_disconnect(sh, "audio_monitoring", HandleInputAudioMonitorTypeChanged, this);
-		signal_handler_disconnect(sh, "media_started", HandleMediaInputPlaybackStarted, this);
-		signal_handler_disconnect(sh, "media_ended", HandleMediaInputPlaybackEnded, this);
-		signal_handler_disconnect(sh, "media_pause", SourceMediaPauseMultiHandler, this);
-		signal_handler_disconnect(sh, "media_play", SourceMediaPlayMultiHandler, this);
-		signal_handler_disconnect(sh, "media_restart", SourceMediaRestartMultiHandler, this);
-		signal_handler_disconnect(sh, "media_stopped", SourceMediaStopMultiHandler, this);
-		signal_handler_disconnect(sh, "media_next", SourceMediaNextMultiHandler, this);
-		signal_handler_disconnect(sh, "media_previous", SourceMediaPreviousMultiHandler, this);
+void EventHandler::SceneItemIndexRemoveHandler(void *param, calldata_t *data)
+{
+	auto eventHandler = static_cast<EventHandler *>(param);
+
+	obs_scene_t *scene = GetCalldataPointer<obs_scene_t>(data, "scene");
+	obs_sceneitem_t *sceneItem = GetCalldataPointer<obs_sceneitem_t>(data, "item");
+	if (!scene || !sceneItem)
+		return;
+
+	OBSSceneItem ref;
+	int64_t sceneItemId = obs_sceneitem_get_id(sceneItem);
+	std::unique_lock<std::shared_mutex> lock(eventHandler->_sceneItemIndexMutex);
+	auto it = eventHandler->_sceneItemIndexes.find(obs_scene_get_source(scene));
+	if (it == eventHandler->_sceneItemIndexes.end())
+		return;
+
+	auto &index = it->second;
+	index.generation++;
+	auto idsIt = index.itemIdsBySource.find(obs_sceneitem_get_source(sceneItem));
+	if (idsIt != index.itemIdsBySource.end()) {
+		auto &sceneItemIds = idsIt->second;
+		sceneItemIds.erase(std::remove(sceneItemIds.begin(), sceneItemIds.end(), sceneItemId), sceneItemIds.end());
+		if (sceneItemIds.empty())
+			index.itemIdsBySource.erase(idsIt);
 	}
 
-	// Scenes
-	if (sourceType == OBS_SOURCE_TYPE_SCENE) {
-		signal_handler_disconnect(sh, "item_add", HandleSceneItemCreated, this);
-		signal_handler_disconnect(sh, "item_remove", HandleSceneItemRemoved, this);
-		signal_handler_disconnect(sh, "reorder", HandleSceneItemListReindexed, this);
-		signal_handler_disconnect(sh, "item_visible", HandleSceneItemEnableStateChanged, this);
-		signal_handler_disconnect(sh, "item_locked", HandleSceneItemLockStateChanged, this);
-		signal_handler_disconnect(sh, "item_select", HandleSceneItemSelected, this);
-		signal_handler_disconnect(sh, "item_transform", HandleSceneItemTransformChanged, this);
+	auto itemIt = index.itemsById.find(sceneItemId);
+	if (itemIt != index.itemsById.end()) {
+		std::swap(itemIt->second, ref);
+		index.itemsById.erase(itemIt);
+	}
+	lock.unlock();
+}
+
+// Reorders, and group changes which are signaled as refreshes, are rare enough to rebuild the index of the whole scene
+void EventHandler::SceneItemIndexRebuildHandler(void *param, calldata_t *data)
+{
+	auto eventHandler = static_cast<EventHandler *>(param);
+
+	obs_scene_t *scene = GetCalldataPointer<obs_scene_t>(data, "scene");
+	if (!scene)
+		return;
+
+	eventHandler->RebuildSceneItemIndex(obs_scene_get_source(scene));
+}
+
+obs_sceneitem_t *EventHandler::GetSceneItemBySource(obs_scene_t *scene, obs_source_t *source, int offset)
+{
+	std::shared_lock<std::shared_mutex> lock(_sceneItemIndexMutex);
+	auto it = _sceneItemIndexes.find(obs_scene_get_source(scene));
+	if (it == _sceneItemIndexes.end())
+		return nullptr;
+
+	auto &index = it->second;
+	auto idsIt = index.itemIdsBySource.find(source);
+	if (idsIt == index.itemIdsBySource.end())
+		return nullptr;
+
+	auto &sceneItemIds = idsIt->second;
+	if (offset >= 0 && (size_t)offset >= sceneItemIds.size())
+		return nullptr;
+
+	auto itemIt = index.itemsById.find(offset < 0 ? sceneItemIds.back() : sceneItemIds[offset]);
+	if (itemIt == index.itemsById.end())
+		return nullptr;
+
+	obs_sceneitem_t *ret = itemIt->second;
+	obs_sceneitem_addref(ret);
+	lock.unlock();
+
+	// The index may briefly lag behind the scene. An item which has left it is left to the caller's own lookup.
+	if (obs_sceneitem_get_scene(ret) != scene) {
+		obs_sceneitem_release(ret);
+		return nullptr;
+	}
+	return ret;
+}
+
+obs_sceneitem_t *EventHandler::GetSceneItemById(obs_scene_t *scene, int64_t sceneItemId)
+{
+	std::shared_lock<std::shared_mutex> lock(_sceneItemIndexMutex);
+	auto it = _sceneItemIndexes.find(obs_scene_get_source(scene));
+	if (it == _sceneItemIndexes.end())
+		return nullptr;
+
+	auto itemIt = it->second.itemsById.find(sceneItemId);
+	if (itemIt == it->second.itemsById.end())
+		return nullptr;
+
+	obs_sceneitem_t *ret = itemIt->second;
+	obs_sceneitem_addref(ret);
+	lock.unlock();
+
+	// See `GetSceneItemBySource()`
+	if (obs_sceneitem_get_scene(ret) != scene) {
+		obs_sceneitem_release(ret);
+		return nullptr;
+	}
+	return ret;
+}
+
+// Hotkey pointers are not stable while hotkeys are registered, so only IDs are kept
+void EventHandler::RebuildHotkeyIndex()
+{
+	// Cleared first, so a change signaled while enumerating causes another rebuild
+	_hotkeyIndexDirty.store(false);
+
+	_hotkeyIdsByName.clear();
+	auto hotkeyCb = [](void *param, obs_hotkey_id id, obs_hotkey_t *hotkey) {
+		auto hotkeyIdsByName = static_cast<std::unordered_map<std::string, obs_hotkey_id> *>(param);
+		hotkeyIdsByName->try_emplace(obs_hotkey_get_name(hotkey), id);
+		return true;
+	};
+	obs_enum_hotkeys(hotkeyCb, &_hotkeyIdsByName);
+
+	_boundHotkeyKeys.clear();
+	auto bindingCb = [](void *param, size_t, obs_hotkey_binding_t *binding) {
+		auto boundHotkeyKeys = static_cast<std::unordered_set<int> *>(param);
+		boundHotkeyKeys->insert(obs_hotkey_binding_get_key_combination(binding).key);
+		return true;
+	};
+	obs_enum_hotkey_bindings(bindingCb, &_boundHotkeyKeys);
+}
+
+void EventHandler::HotkeyIndexInvalidatedHandler(void *param, calldata_t *)
+{
+	auto eventHandler = static_cast<EventHandler *>(param);
+	eventHandler->_hotkeyIndexDirty.store(true);
+}
+
+bool EventHandler::GetHotkeyIdByName(const std::string &hotkeyName, obs_hotkey_id &hotkeyId)
+{
+	std::unique_lock<std::mutex> lock(_hotkeyIndexMutex);
+	if (_hotkeyIndexDirty.load())
+		RebuildHotkeyIndex();
+
+	auto it = _hotkeyIdsByName.find(hotkeyName);
+	if (it == _hotkeyIdsByName.end())
+		return false;
+
+	hotkeyId = it->second;
+	return true;
+}
+
+bool EventHandler::IsHotkeyKeyBound(obs_key_t key)
+{
+	std::unique_lock<std::mutex> lock(_hotkeyIndexMutex);
+	if (_hotkeyIndexDirty.load())
+		RebuildHotkeyIndex();
+
+	return _boundHotkeyKeys.count(key);
+}
+
+// Called on the 0 -> 1 refcount transition of subscription bits. Only touches registered sources, and only for the added categories.
+// Called with `_subscriptionMutex` held, which keeps category connects and disconnects in order.
+void EventHandler::ConnectSignalCategories(uint64_t eventSubscriptions)
+{
+	std::unique_lock<std::mutex> lock(_sourceRegistryMutex);
+	eventSubscriptions &= ~_connectedSourceSignals;
+	_connectedSourceSignals |= eventSubscriptions;
+
+	if (!_obsLoaded.load())
+		return;
+
+	bool hasCategory = false;
+	for (auto &category : _sourceSignalCategories)
+		hasCategory |= (eventSubscriptions & category.eventSubscription) != 0;
+	if (!hasCategory)
+		return;
+
+	auto sources = GetRegisteredSources();
+	lock.unlock();
+
+	for (auto &source : sources)
+		ConnectSourceSignals(source, eventSubscriptions);
+
+	if ((eventSubscriptions & EventSubscription::Transitions) != 0) {
+		obs_frontend_source_list transitions = {};
+		obs_frontend_get_transitions(&transitions);
+		for (size_t i = 0; i < transitions.sources.num; i++)
+			ConnectSourceSignals(transitions.sources.array[i], EventSubscription::Transitions);
+		obs_frontend_source_list_free(&transitions);
+	}
+}
+
+// Called on the 1 -> 0 refcount transition of subscription bits
+void EventHandler::DisconnectSignalCategories(uint64_t eventSubscriptions)
+{
+	std::unique_lock<std::mutex> lock(_sourceRegistryMutex);
+	eventSubscriptions &= _connectedSourceSignals;
+	_connectedSourceSignals &= ~eventSubscriptions;
+
+	if (!_obsLoaded.load())
+		return;
+
+	bool hasCategory = false;
+	for (auto &category : _sourceSignalCategories)
+		hasCategory |= (eventSubscriptions & category.eventSubscription) != 0;
+	if (!hasCategory)
+		return;
+
+	auto sources = GetRegisteredSources();
+	lock.unlock();
+
+	for (auto &source : sources)
+		DisconnectSourceSignals(source, eventSubscriptions);
+
+	if ((eventSubscriptions & EventSubscription::Transitions) != 0) {
+		obs_frontend_source_list transitions = {};
+		obs_frontend_get_transitions(&transitions);
+		for (size_t i = 0; i < transitions.sources.num; i++)
+			DisconnectSourceSignals(transitions.sources.array[i], EventSubscription::Transitions);
+		obs_frontend_source_list_free(&transitions);
+	}
+}
+
+// Strong refs to every registered source, so their signals can be (dis)connected after the registry lock is released.
+// Sources already being destroyed are skipped, their `source_destroy` handler takes care of them.
+// Must be called with `_sourceRegistryMutex` held, and the result released without it
+std::vector<OBSSourceAutoRelease> EventHandler::GetRegisteredSources()
+{
+	std::vector<OBSSourceAutoRelease> ret;
+	ret.reserve(_sourceRegistry.size());
+	for (auto source : _sourceRegistry) {
+		obs_source_t *ref = obs_source_get_ref(source);
+		if (ref)
+			ret.emplace_back(ref);
+	}
+	return ret;
+}
+
+// Transitions are private sources owned by the frontend, so they are tracked through the frontend's transition list instead of the registry
+void EventHandler::ReconnectTransitionSignals()
+{
+	if ((_connectedSourceSignals & EventSubscription::Transitions) == 0)
+		return;
+
+	obs_frontend_source_list transitions = {};
+	obs_frontend_get_transitions(&transitions);
+	for (size_t i = 0; i < transitions.sources.num; i++) {
+		obs_source_t *transition = transitions.sources.array[i];
+		// Disconnect first to prevent multiple connections
+		DisconnectSourceSignals(transition, EventSubscription::Transitions);
+		ConnectSourceSignals(transition, EventSubscription::Transitions);
+	}
+	obs_frontend_source_list_free(&transitions);
+}
+
+void EventHandler::DisconnectTransitionSignals()
+{
+	if ((_connectedSourceSignals & EventSubscription::Transitions) == 0)
+		return;
+
+	obs_frontend_source_list transitions = {};
+	obs_frontend_get_transitions(&transitions);
+	for (size_t i = 0; i < transitions.sources.num; i++)
+		DisconnectSourceSignals(transitions.sources.array[i], EventSubscription::Transitions);
+	obs_frontend_source_list_free(&transitions);
+}
+
+// Connect the signals of every category in `eventSubscriptions` which applies to the source's type. Filters of inputs and scenes are connected along with them.
+// Must not be called with `_sourceRegistryMutex` held
+void EventHandler::ConnectSourceSignals(obs_source_t *source, uint64_t eventSubscriptions)
+{
+	if (!source || !eventSubscriptions)
+		return;
+
+	signal_handler_t *sh = obs_source_get_signal_handler(source);
+
+	obs_source_type sourceType = obs_source_get_type(source);
+
+	for (auto &category : _sourceSignalCategories) {
+		if ((eventSubscriptions & category.eventSubscription) == 0 || category.sourceType != sourceType)
+			continue;
+		for (auto &sourceSignal : category.signals)
+			signal_handler_connect(sh, sourceSignal.signal, sourceSignal.callback, this);
 	}
 
-	// Inputs and Scenes
-	if (sourceType == OBS_SOURCE_TYPE_INPUT || sourceType == OBS_SOURCE_TYPE_SCENE) {
-		signal_handler_disconnect(sh, "reorder_filters", HandleSourceFilterListReindexed, this);
-		signal_handler_disconnect(sh, "filter_add", FilterAddMultiHandler, this);
-		signal_handler_disconnect(sh, "filter_remove", FilterRemoveMultiHandler, this);
+	if ((eventSubscriptions & EventSubscription::Filters) != 0 &&
+	    (sourceType == OBS_SOURCE_TYPE_INPUT || sourceType == OBS_SOURCE_TYPE_SCENE)) {
 		auto enumFilters = [](obs_source_t *, obs_source_t *filter, void *param) {
 			auto eventHandler = static_cast<EventHandler *>(param);
-			eventHandler->DisconnectSourceSignals(filter);
+			eventHandler->ConnectSourceSignals(filter, EventSubscription::Filters);
 		};
 		obs_source_enum_filters(source, enumFilters, this);
 	}
+}
 
-	// Transitions
-	if (sourceType == OBS_SOURCE_TYPE_TRANSITION) {
-		signal_handler_disconnect(sh, "transition_start", HandleSceneTransitionStarted, this);
-		signal_handler_disconnect(sh, "transition_stop", HandleSceneTransitionEnded, this);
-		signal_handler_disconnect(sh, "transition_video_stop", HandleSceneTransitionVideoEnded, this);
+// Must not be called with `_sourceRegistryMutex` held
+void EventHandler::DisconnectSourceSignals(obs_source_t *source, uint64_t eventSubscriptions)
+{
+	if (!source || !eventSubscriptions)
+		return;
+
+	signal_handler_t *sh = obs_source_get_signal_handler(source);
+
+	obs_source_type sourceType = obs_source_get_type(source);
+
+	for (auto &category : _sourceSignalCategories) {
+		if ((eventSubscriptions & category.eventSubscription) == 0 || category.sourceType != sourceType)
+			continue;
+		for (auto &sourceSignal : category.signals)
+			signal_handler_disconnect(sh, sourceSignal.signal, sourceSignal.callback, this);
 	}
 
-	// Filters
-	if (sourceType == OBS_SOURCE_TYPE_FILTER) {
-		signal_handler_disconnect(sh, "enable", HandleSourceFilterEnableStateChanged, this);
-		signal_handler_disconnect(sh, "rename", HandleSourceFilterNameChanged, this);
+	if ((eventSubscriptions & EventSubscription::Filters) != 0 &&
+	    (sourceType == OBS_SOURCE_TYPE_INPUT || sourceType == OBS_SOURCE_TYPE_SCENE)) {
+		auto enumFilters = [](obs_source_t *, obs_source_t *filter, void *param) {
+			auto eventHandler = static_cast<EventHandler *>(param);
+			eventHandler->DisconnectSourceSignals(filter, EventSubscription::Filters);
+		};
+		obs_source_enum_filters(source, enumFilters, this);
 	}
 }
 
@@ -274,36 +750,27 @@ void EventHandler::OnFrontendEvent(enum obs_frontend_event event, void *private_
 		eventHandler->_obsLoaded.store(true);
 
 		// In the case that plugins become hotloadable, this will have to go back into `EventHandler::EventHandler()`
-		// Enumerate inputs and connect each one
+		// Enumerate inputs and register each one. Signals are only connected for currently subscribed categories.
 		{
 			auto enumInputs = [](void *param, obs_source_t *source) {
 				auto eventHandler = static_cast<EventHandler *>(param);
-				eventHandler->ConnectSourceSignals(source);
+				eventHandler->RegisterSource(source);
 				return true;
 			};
 			obs_enum_sources(enumInputs, private_data);
 		}
 
-		// Enumerate scenes and connect each one
+		// Enumerate scenes and register each one
 		{
 			auto enumScenes = [](void *param, obs_source_t *source) {
 				auto eventHandler = static_cast<EventHandler *>(param);
-				eventHandler->ConnectSourceSignals(source);
+				eventHandler->RegisterSource(source);
 				return true;
 			};
 			obs_enum_scenes(enumScenes, private_data);
 		}
 
-		// Enumerate all scene transitions and connect each one
-		{
-			obs_frontend_source_list transitions = {};
-			obs_frontend_get_transitions(&transitions);
-			for (size_t i = 0; i < transitions.sources.num; i++) {
-				obs_source_t *transition = transitions.sources.array[i];
-				eventHandler->ConnectSourceSignals(transition);
-			}
-			obs_frontend_source_list_free(&transitions);
-		}
+		eventHandler->ReconnectTransitionSignals();
 
 		blog_debug("[EventHandler::OnFrontendEvent] Finished.");
 
@@ -322,35 +789,31 @@ void EventHandler::OnFrontendEvent(enum obs_frontend_event event, void *private_
 		eventHandler->_obsLoaded.store(false);
 
 		// In the case that plugins become hotloadable, this will have to go back into `EventHandler::~EventHandler()`
-		// Enumerate inputs and disconnect each one
+		// Disconnect and unregister every registered source
+		eventHandler->DisconnectTransitionSignals();
 		{
-			auto enumInputs = [](void *param, obs_source_t *source) {
-				auto eventHandler = static_cast<EventHandler *>(param);
-				eventHandler->DisconnectSourceSignals(source);
-				return true;
-			};
-			obs_enum_sources(enumInputs, private_data);
+			std::unique_lock<std::mutex> lock(eventHandler->_sourceRegistryMutex);
+			auto sources = eventHandler->GetRegisteredSources();
+			uint64_t connectedSourceSignals = eventHandler->_connectedSourceSignals;
+			eventHandler->_sourceRegistry.clear();
+			lock.unlock();
+
+			for (auto &source : sources)
+				eventHandler->DisconnectSourceSignals(source, connectedSourceSignals);
 		}
-
-		// Enumerate scenes and disconnect each one
 		{
-			auto enumScenes = [](void *param, obs_source_t *source) {
-				auto eventHandler = static_cast<EventHandler *>(param);
-				eventHandler->DisconnectSourceSignals(source);
-				return true;
-			};
-			obs_enum_scenes(enumScenes, private_data);
+			std::unique_lock<std::shared_mutex> lock(eventHandler->_sourceNameIndexMutex);
+			eventHandler->_sourceNameIndex.clear();
 		}
-
-		// Enumerate all scene transitions and disconnect each one
 		{
-			obs_frontend_source_list transitions = {};
-			obs_frontend_get_transitions(&transitions);
-			for (size_t i = 0; i < transitions.sources.num; i++) {
-				obs_source_t *transition = transitions.sources.array[i];
-				eventHandler->DisconnectSourceSignals(transition);
+			std::vector<obs_source_t *> sceneSources;
+			{
+				std::shared_lock<std::shared_mutex> lock(eventHandler->_sceneItemIndexMutex);
+				for (auto &[sceneSource, index] : eventHandler->_sceneItemIndexes)
+					sceneSources.push_back(sceneSource);
 			}
-			obs_frontend_source_list_free(&transitions);
+			for (auto sceneSource : sceneSources)
+				eventHandler->DisconnectSceneItemIndex(sceneSource);
 		}
 
 		blog_debug("[EventHandler::OnFrontendEvent] Finished.");
@@ -365,30 +828,25 @@ void EventHandler::OnFrontendEvent(enum obs_frontend_event event, void *private_
 
 	// Config
 	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING: {
-		obs_frontend_source_list transitions = {};
-		obs_frontend_get_transitions(&transitions);
-		for (size_t i = 0; i < transitions.sources.num; i++) {
-			obs_source_t *transition = transitions.sources.array[i];
-			eventHandler->DisconnectSourceSignals(transition);
-		}
-		obs_frontend_source_list_free(&transitions);
-	}
+		eventHandler->DisconnectTransitionSignals();
 		eventHandler->HandleCurrentSceneCollectionChanging();
-		break;
-	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED: {
-		obs_frontend_source_list transitions = {};
-		obs_frontend_get_transitions(&transitions);
-		for (size_t i = 0; i < transitions.sources.num; i++) {
-			obs_source_t *transition = transitions.sources.array[i];
-			eventHandler->ConnectSourceSignals(transition);
+		// Objects of the old collection are removed and those of the new one created until `CHANGED`
+		auto conf = GetConfig();
+		if (conf && conf->SceneCollectionEventMode != All) {
+			eventHandler->_sceneCollectionEventMode.store(conf->SceneCollectionEventMode);
+			eventHandler->_suppressedSubscriptions.store(SceneCollectionSuppressedSubscriptions);
 		}
-		obs_frontend_source_list_free(&transitions);
-	}
+	} break;
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
+		eventHandler->ReconnectTransitionSignals();
 		eventHandler->HandleCurrentSceneCollectionChanged();
+		eventHandler->HandleSceneCollectionLoaded();
 		break;
 	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_LIST_CHANGED:
 		eventHandler->HandleSceneCollectionListChanged();
 		break;
+	// A profile switch only changes output, encoder and video settings. No scenes, inputs or transitions are recreated,
+	// so there are no per-object events to hold back.
 	case OBS_FRONTEND_EVENT_PROFILE_CHANGING:
 		eventHandler->HandleCurrentProfileChanging();
 		break;
@@ -414,15 +872,9 @@ void EventHandler::OnFrontendEvent(enum obs_frontend_event event, void *private_
 	case OBS_FRONTEND_EVENT_TRANSITION_CHANGED:
 		eventHandler->HandleCurrentSceneTransitionChanged();
 		break;
-	case OBS_FRONTEND_EVENT_TRANSITION_LIST_CHANGED: {
-		obs_frontend_source_list transitions = {};
-		obs_frontend_get_transitions(&transitions);
-		for (size_t i = 0; i < transitions.sources.num; i++) {
-			obs_source_t *transition = transitions.sources.array[i];
-			eventHandler->ConnectSourceSignals(transition);
-		}
-		obs_frontend_source_list_free(&transitions);
-	} break;
+	case OBS_FRONTEND_EVENT_TRANSITION_LIST_CHANGED:
+		eventHandler->ReconnectTransitionSignals();
+		break;
 	case OBS_FRONTEND_EVENT_TRANSITION_DURATION_CHANGED:
 		eventHandler->HandleCurrentSceneTransitionDurationChanged();
 		break;
@@ -501,7 +953,7 @@ void EventHandler::SourceCreatedMultiHandler(void *param, calldata_t *data)
 	if (!source)
 		return;
 
-	eventHandler->ConnectSourceSignals(source);
+	eventHandler->RegisterSource(source);
 
 	switch (obs_source_get_type(source)) {
 	case OBS_SOURCE_TYPE_INPUT:
@@ -527,7 +979,7 @@ void EventHandler::SourceDestroyedMultiHandler(void *param, calldata_t *data)
 		return;
 
 	// Disconnect all signals from the source
-	eventHandler->DisconnectSourceSignals(source);
+	eventHandler->UnregisterSource(source);
 
 	// Don't react to signals if OBS is unloading
 	if (!eventHandler->_obsLoaded.load())
@@ -562,6 +1014,9 @@ void EventHandler::SourceRemovedMultiHandler(void *param, calldata_t *data)
 	if (!source)
 		return;
 
+	// Removed sources stay registered until they are destroyed, but can no longer be found by name
+	eventHandler->UnindexSourceName(source, obs_source_get_name(source));
+
 	switch (obs_source_get_type(source)) {
 	case OBS_SOURCE_TYPE_INPUT:
 		eventHandler->HandleInputRemoved(source);
@@ -590,6 +1045,14 @@ void EventHandler::SourceRenamedMultiHandler(void *param, calldata_t *data)
 	if (oldSourceName.empty() || sourceName.empty())
 		return;
 
+	{
+		std::unique_lock<std::mutex> lock(eventHandler->_sourceRegistryMutex);
+		if (eventHandler->_sourceRegistry.count(source) && !obs_source_removed(source)) {
+			eventHandler->UnindexSourceName(source, oldSourceName);
+			eventHandler->IndexSourceName(source, sourceName);
+		}
+	}
+
 	switch (obs_source_get_type(source)) {
 	case OBS_SOURCE_TYPE_INPUT:
 		eventHandler->HandleInputNameChanged(source, oldSourceName, sourceName);
@@ -19,10 +19,17 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <obs.hpp>
 #include <obs-frontend-api.h>
 
+#include "types/Event.h"
 #include "types/EventSubscription.h"
 #include "../obs-websocket.h"
 #include "../utils/Obs.h"
@@ -34,13 +41,34 @@ public:
 	EventHandler();
 	~EventHandler();
 
-	typedef std::function<void(uint64_t, std::string, json, uint8_t)> BroadcastCallback;
+	// How per-object events are sent while the scene collection changes. `Summary` replaces them with a single
+	// `SceneCollectionLoaded` event, and `SummaryWithInventory` also lists every scene, input and transition in it.
+	enum SceneCollectionEventMode { All, Summary, SummaryWithInventory };
+
+	typedef std::function<void(std::shared_ptr<Event>)> BroadcastCallback;
 	void SetBroadcastCallback(BroadcastCallback cb);
 	typedef std::function<void()> ObsLoadedCallback;
 	void SetObsLoadedCallback(ObsLoadedCallback cb);
 
 	void ProcessSubscription(uint64_t eventSubscriptions);
 	void ProcessUnsubscription(uint64_t eventSubscriptions);
+	// Whether any session (or local consumer) is subscribed to at least one of the bits in `requiredIntent`, and events
+	// with that intent are not currently suppressed
+	inline bool HasSubscribers(uint64_t requiredIntent) const
+	{
+		return (_subscriptionMask.load(std::memory_order_relaxed) &
+			~_suppressedSubscriptions.load(std::memory_order_relaxed) & requiredIntent) != 0;
+	}
+
+	// Strong reference to the registered input or scene named `sourceName`, or nullptr if there is none
+	obs_source_t *GetSourceByName(const std::string &sourceName);
+	// Strong references to items of a registered scene, or nullptr if the scene or item is not indexed. A negative
+	// `offset` selects the topmost item using `source`, otherwise items are counted from the bottom.
+	obs_sceneitem_t *GetSceneItemBySource(obs_scene_t *scene, obs_source_t *source, int offset = 0);
+	obs_sceneitem_t *GetSceneItemById(obs_scene_t *scene, int64_t sceneItemId);
+	// Hotkeys are resolved through an index which is rebuilt on first use after hotkeys or their bindings changed
+	bool GetHotkeyIdByName(const std::string &hotkeyName, obs_hotkey_id &hotkeyId);
+	bool IsHotkeyKeyBound(obs_key_t key);
 
 private:
 	BroadcastCallback _broadcastCallback;
@@ -49,13 +77,75 @@ private:
 	std::atomic<bool> _obsLoaded;
 
 	std::unique_ptr<Utils::Obs::VolumeMeter::Handler> _inputVolumeMetersHandler;
-	std::atomic<uint64_t> _inputVolumeMetersRef;
-	std::atomic<uint64_t> _inputActiveStateChangedRef;
-	std::atomic<uint64_t> _inputShowStateChangedRef;
-	std::atomic<uint64_t> _sceneItemTransformChangedRef;
 
-	void ConnectSourceSignals(obs_source_t *source);
-	void DisconnectSourceSignals(obs_source_t *source);
+	// Per-bit refcounts of all active subscriptions, and the union of every bit with a non-zero refcount
+	std::mutex _subscriptionMutex;
+	std::array<uint64_t, 64> _subscriptionRefs;
+	std::atomic<uint64_t> _subscriptionMask;
+	std::atomic<uint64_t> _suppressedSubscriptions; // Intents whose events are not generated, regardless of subscribers
+	std::atomic<uint8_t> _sceneCollectionEventMode; // Mode of the scene collection change in progress
+
+	// Per-source signals, grouped by the subscription which needs them. Only connected while that subscription has refs.
+	struct SourceSignal {
+		const char *signal;
+		signal_callback_t callback;
+	};
+	struct SourceSignalCategory {
+		uint64_t eventSubscription;
+		obs_source_type sourceType;
+		std::vector<SourceSignal> signals;
+	};
+	static const std::vector<SourceSignalCategory> _sourceSignalCategories;
+
+	std::mutex _sourceRegistryMutex;
+	std::unordered_set<obs_source_t *> _sourceRegistry; // Public inputs and scenes, kept current by source_create/source_destroy
+	std::atomic<uint64_t> _connectedSourceSignals;        // Subscription bits whose source signals are currently connected. Written under `_sourceRegistryMutex`
+
+	// Name -> registered source, so requests can resolve names without going through the libobs source list
+	std::shared_mutex _sourceNameIndexMutex;
+	std::unordered_map<std::string, OBSWeakSourceAutoRelease> _sourceNameIndex;
+
+	void RegisterSource(obs_source_t *source);
+	void UnregisterSource(obs_source_t *source);
+	void IndexSourceName(obs_source_t *source, const std::string &sourceName);
+	void UnindexSourceName(obs_source_t *source, const std::string &sourceName);
+
+	// Items of every registered scene, by source and by ID. Kept current by scene signals which are always connected,
+	// unlike the ones behind scene item events.
+	struct SceneItemIndex {
+		std::unordered_map<obs_source_t *, std::vector<int64_t>> itemIdsBySource; // Bottom to top
+		std::unordered_map<int64_t, OBSSceneItem> itemsById;                      // Refs are held until the item is removed
+		uint64_t generation = 0;                                                  // Bumped on every change, so rebuilds can detect concurrent ones
+	};
+	std::shared_mutex _sceneItemIndexMutex;
+	std::unordered_map<obs_source_t *, SceneItemIndex> _sceneItemIndexes; // Scene source -> index
+
+	void ConnectSceneItemIndex(obs_source_t *sceneSource);
+	void DisconnectSceneItemIndex(obs_source_t *sceneSource);
+	void RebuildSceneItemIndex(obs_source_t *sceneSource);
+	static void SceneItemIndexAddHandler(void *param, calldata_t *data);
+	static void SceneItemIndexRemoveHandler(void *param, calldata_t *data);
+	static void SceneItemIndexRebuildHandler(void *param, calldata_t *data);
+
+	std::mutex _hotkeyIndexMutex;
+	std::atomic<bool> _hotkeyIndexDirty;                             // Set by the hotkey signals, without taking the mutex
+	std::unordered_map<std::string, obs_hotkey_id> _hotkeyIdsByName; // First registered hotkey of each name
+	std::unordered_set<int> _boundHotkeyKeys;                        // `obs_key_t` of every binding
+	void RebuildHotkeyIndex();
+	static void HotkeyIndexInvalidatedHandler(void *param, calldata_t *data);
+	void ConnectSignalCategories(uint64_t eventSubscriptions);
+	void DisconnectSignalCategories(uint64_t eventSubscriptions);
+	std::vector<OBSSourceAutoRelease> GetRegisteredSources();
+	void ReconnectTransitionSignals();
+	void DisconnectTransitionSignals();
+	void ConnectSourceSignals(obs_source_t *source, uint64_t eventSubscriptions);
+	void DisconnectSourceSignals(obs_source_t *source, uint64_t eventSubscriptions);
+
+	// SceneItemTransformChanged is coalesced per scene item. Only the latest transform is sent, once per video frame.
+	std::mutex _pendingSceneItemTransformsMutex;
+	std::map<std::pair<obs_source_t *, int64_t>, obs_weak_source_t *> _pendingSceneItemTransforms;
+	static void SceneItemTransformTick(void *param, float);
+	void ClearPendingSceneItemTransforms();
 
 	void BroadcastEvent(uint64_t requiredIntent, std::string eventType, json eventData = nullptr, uint8_t rpcVersion = 0);
 
@@ -88,6 +178,7 @@ private:
 	void HandleCurrentProfileChanging();
 	void HandleCurrentProfileChanged();
 	void HandleProfileListChanged();
+	void HandleSceneCollectionLoaded();
 
 	// Scenes
 	void HandleSceneCreated(obs_source_t *source);
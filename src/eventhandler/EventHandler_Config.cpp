@@ -37,9 +37,12 @@ with this program. If not, see <https://www.gnu.org/licenses/>
  */
 void EventHandler::HandleCurrentSceneCollectionChanging()
 {
+	if (!HasSubscribers(EventSubscription::Config))
+		return;
+
 	json eventData;
 	eventData["sceneCollectionName"] = Utils::Obs::StringHelper::GetCurrentSceneCollection();
-	BroadcastEvent(EventSubscription::Config, "CurrentSceneCollectionChanging", eventData);
+	BroadcastEvent(EventSubscription::Config, "CurrentSceneCollectionChanging", std::move(eventData));
 }
 
 /**
@@ -59,9 +62,12 @@ void EventHandler::HandleCurrentSceneCollectionChanging()
  */
 void EventHandler::HandleCurrentSceneCollectionChanged()
 {
+	if (!HasSubscribers(EventSubscription::Config))
+		return;
+
 	json eventData;
 	eventData["sceneCollectionName"] = Utils::Obs::StringHelper::GetCurrentSceneCollection();
-	BroadcastEvent(EventSubscription::Config, "CurrentSceneCollectionChanged", eventData);
+	BroadcastEvent(EventSubscription::Config, "CurrentSceneCollectionChanged", std::move(eventData));
 }
 
 /**
@@ -79,9 +85,12 @@ void EventHandler::HandleCurrentSceneCollectionChanged()
  */
 void EventHandler::HandleSceneCollectionListChanged()
 {
+	if (!HasSubscribers(EventSubscription::Config))
+		return;
+
 	json eventData;
 	eventData["sceneCollections"] = Utils::Obs::ArrayHelper::GetSceneCollectionList();
-	BroadcastEvent(EventSubscription::Config, "SceneCollectionListChanged", eventData);
+	BroadcastEvent(EventSubscription::Config, "SceneCollectionListChanged", std::move(eventData));
 }
 
 /**
@@ -99,9 +108,12 @@ void EventHandler::HandleSceneCollectionListChanged()
  */
 void EventHandler::HandleCurrentProfileChanging()
 {
+	if (!HasSubscribers(EventSubscription::Config))
+		return;
+
 	json eventData;
 	eventData["profileName"] = Utils::Obs::StringHelper::GetCurrentProfile();
-	BroadcastEvent(EventSubscription::Config, "CurrentProfileChanging", eventData);
+	BroadcastEvent(EventSubscription::Config, "CurrentProfileChanging", std::move(eventData));
 }
 
 /**
@@ -119,9 +131,12 @@ void EventHandler::HandleCurrentProfileChanging()
  */
 void EventHandler::HandleCurrentProfileChanged()
 {
+	if (!HasSubscribers(EventSubscription::Config))
+		return;
+
 	json eventData;
 	eventData["profileName"] = Utils::Obs::StringHelper::GetCurrentProfile();
-	BroadcastEvent(EventSubscription::Config, "CurrentProfileChanged", eventData);
+	BroadcastEvent(EventSubscription::Config, "CurrentProfileChanged", std::move(eventData));
 }
 
 /**
@@ -139,7 +154,73 @@ void EventHandler::HandleCurrentProfileChanged()
  */
 void EventHandler::HandleProfileListChanged()
 {
+	if (!HasSubscribers(EventSubscription::Config))
+		return;
+
 	json eventData;
 	eventData["profiles"] = Utils::Obs::ArrayHelper::GetProfileList();
-	BroadcastEvent(EventSubscription::Config, "ProfileListChanged", eventData);
+	BroadcastEvent(EventSubscription::Config, "ProfileListChanged", std::move(eventData));
+}
+
+/**
+ * The new scene collection has finished loading.
+ *
+ * Only sent if obs-websocket is configured to hold back per-object events (`SceneCollectionEventMode`) during a scene
+ * collection change. In that case, `Scenes`, `Inputs`, `Transitions`, `Filters`, `SceneItems` and `MediaInputs` events
+ * are not sent between `CurrentSceneCollectionChanging` and this event, and clients should resync from it instead.
+ *
+ * @dataField sceneCollectionName     | String        | Name of the new scene collection
+ * @dataField currentProgramSceneName | String        | Name of the current program scene
+ * @dataField currentPreviewSceneName | String        | Name of the current preview scene. `null` if not in studio mode
+ * @dataField sceneCount              | Number        | Number of scenes in the collection
+ * @dataField inputCount              | Number        | Number of inputs in the collection
+ * @dataField scenes                  | Array<Object> | Every scene, same as `GetSceneList`. Only present if the inventory is enabled
+ * @dataField inputs                  | Array<Object> | Every input, same as `GetInputList`. Only present if the inventory is enabled
+ * @dataField transitions             | Array<Object> | Every scene transition, same as `GetSceneTransitionList`. Only present if the inventory is enabled
+ *
+ * @eventType SceneCollectionLoaded
+ * @eventSubscription Config
+ * @complexity 2
+ * @rpcVersion -1
+ * @initialVersion 5.1.0
+ * @category config
+ * @api events
+ */
+void EventHandler::HandleSceneCollectionLoaded()
+{
+	uint8_t mode = _sceneCollectionEventMode.exchange(All);
+	if (mode == All)
+		return;
+
+	_suppressedSubscriptions.store(0);
+
+	if (!HasSubscribers(EventSubscription::Config))
+		return;
+
+	OBSSourceAutoRelease currentProgramScene = obs_frontend_get_current_scene();
+	OBSSourceAutoRelease currentPreviewScene = obs_frontend_get_current_preview_scene();
+
+	size_t inputCount = 0;
+	auto inputEnumProc = [](void *param, obs_source_t *) {
+		auto inputCount = static_cast<size_t *>(param);
+		(*inputCount)++;
+		return true;
+	};
+	obs_enum_sources(inputEnumProc, &inputCount);
+
+	json eventData;
+	eventData["sceneCollectionName"] = Utils::Obs::StringHelper::GetCurrentSceneCollection();
+	eventData["currentProgramSceneName"] = obs_source_get_name(currentProgramScene);
+	if (currentPreviewScene)
+		eventData["currentPreviewSceneName"] = obs_source_get_name(currentPreviewScene);
+	else
+		eventData["currentPreviewSceneName"] = nullptr;
+	eventData["sceneCount"] = Utils::Obs::NumberHelper::GetSceneCount();
+	eventData["inputCount"] = inputCount;
+	if (mode == SummaryWithInventory) {
+		eventData["scenes"] = Utils::Obs::ArrayHelper::GetSceneList();
+		eventData["inputs"] = Utils::Obs::ArrayHelper::GetInputList();
+		eventData["transitions"] = Utils::Obs::ArrayHelper::GetSceneTransitionList();
+	}
+	BroadcastEvent(EventSubscription::Config, "SceneCollectionLoaded", std::move(eventData));
 }
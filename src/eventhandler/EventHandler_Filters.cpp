@@ -29,7 +29,8 @@ void EventHandler::FilterAddMultiHandler(void *param, calldata_t *data)
 	if (!(source && filter))
 		return;
 
-	eventHandler->ConnectSourceSignals(filter);
+	// Runs with the source's signal mutex held, so the registry lock must not be taken here
+	eventHandler->ConnectSourceSignals(filter, eventHandler->_connectedSourceSignals);
 
 	eventHandler->HandleSourceFilterCreated(source, filter);
 }
@@ -44,7 +45,8 @@ void EventHandler::FilterRemoveMultiHandler(void *param, calldata_t *data)
 	if (!(source && filter))
 		return;
 
-	eventHandler->DisconnectSourceSignals(filter);
+	// Runs with the source's signal mutex held, so the registry lock must not be taken here
+	eventHandler->DisconnectSourceSignals(filter, eventHandler->_connectedSourceSignals);
 
 	eventHandler->HandleSourceFilterRemoved(source, filter);
 }
@@ -67,6 +69,9 @@ void EventHandler::HandleSourceFilterListReindexed(void *param, calldata_t *data
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Filters))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -74,7 +79,7 @@ void EventHandler::HandleSourceFilterListReindexed(void *param, calldata_t *data
 	json eventData;
 	eventData["sourceName"] = obs_source_get_name(source);
 	eventData["filters"] = Utils::Obs::ArrayHelper::GetSourceFilterList(source);
-	eventHandler->BroadcastEvent(EventSubscription::Filters, "SourceFilterListReindexed", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Filters, "SourceFilterListReindexed", std::move(eventData));
 }
 
 /**
@@ -97,6 +102,9 @@ void EventHandler::HandleSourceFilterListReindexed(void *param, calldata_t *data
  */
 void EventHandler::HandleSourceFilterCreated(obs_source_t *source, obs_source_t *filter)
 {
+	if (!HasSubscribers(EventSubscription::Filters))
+		return;
+
 	std::string filterKind = obs_source_get_id(filter);
 	OBSDataAutoRelease filterSettings = obs_source_get_settings(filter);
 	OBSDataAutoRelease defaultFilterSettings = obs_get_source_defaults(filterKind.c_str());
@@ -108,7 +116,7 @@ void EventHandler::HandleSourceFilterCreated(obs_source_t *source, obs_source_t
 	eventData["filterIndex"] = Utils::Obs::NumberHelper::GetSourceFilterIndex(source, filter);
 	eventData["filterSettings"] = Utils::Json::ObsDataToJson(filterSettings);
 	eventData["defaultFilterSettings"] = Utils::Json::ObsDataToJson(defaultFilterSettings, true);
-	BroadcastEvent(EventSubscription::Filters, "SourceFilterCreated", eventData);
+	BroadcastEvent(EventSubscription::Filters, "SourceFilterCreated", std::move(eventData));
 }
 
 /**
@@ -127,10 +135,13 @@ void EventHandler::HandleSourceFilterCreated(obs_source_t *source, obs_source_t
  */
 void EventHandler::HandleSourceFilterRemoved(obs_source_t *source, obs_source_t *filter)
 {
+	if (!HasSubscribers(EventSubscription::Filters))
+		return;
+
 	json eventData;
 	eventData["sourceName"] = obs_source_get_name(source);
 	eventData["filterName"] = obs_source_get_name(filter);
-	BroadcastEvent(EventSubscription::Filters, "SourceFilterRemoved", eventData);
+	BroadcastEvent(EventSubscription::Filters, "SourceFilterRemoved", std::move(eventData));
 }
 
 /**
@@ -152,6 +163,9 @@ void EventHandler::HandleSourceFilterNameChanged(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Filters))
+		return;
+
 	obs_source_t *filter = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!filter)
 		return;
@@ -160,7 +174,7 @@ void EventHandler::HandleSourceFilterNameChanged(void *param, calldata_t *data)
 	eventData["sourceName"] = obs_source_get_name(obs_filter_get_parent(filter));
 	eventData["oldFilterName"] = calldata_string(data, "prev_name");
 	eventData["filterName"] = calldata_string(data, "new_name");
-	eventHandler->BroadcastEvent(EventSubscription::Filters, "SourceFilterNameChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Filters, "SourceFilterNameChanged", std::move(eventData));
 }
 
 /**
@@ -182,6 +196,9 @@ void EventHandler::HandleSourceFilterEnableStateChanged(void *param, calldata_t
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Filters))
+		return;
+
 	obs_source_t *filter = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!filter)
 		return;
@@ -197,5 +214,5 @@ void EventHandler::HandleSourceFilterEnableStateChanged(void *param, calldata_t
 	eventData["sourceName"] = obs_source_get_name(source);
 	eventData["filterName"] = obs_source_get_name(filter);
 	eventData["filterEnabled"] = filterEnabled;
-	eventHandler->BroadcastEvent(EventSubscription::Filters, "SourceFilterEnableStateChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Filters, "SourceFilterEnableStateChanged", std::move(eventData));
 }
@@ -32,10 +32,16 @@ with this program. If not, see <https://www.gnu.org/licenses/>
  */
 void EventHandler::HandleExitStarted()
 {
+	if (!HasSubscribers(EventSubscription::General))
+		return;
+
 	BroadcastEvent(EventSubscription::General, "ExitStarted");
 }
 
 void EventHandler::HandleMainWindowClickHide()
 {
+	if (!HasSubscribers(EventSubscription::General))
+		return;
+
 	BroadcastEvent(EventSubscription::General, "MainWindowDidClickHide");
 }
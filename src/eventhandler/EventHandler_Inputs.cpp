@@ -38,6 +38,9 @@ with this program. If not, see <https://www.gnu.org/licenses/>
  */
 void EventHandler::HandleInputCreated(obs_source_t *source)
 {
+	if (!HasSubscribers(EventSubscription::Inputs))
+		return;
+
 	std::string inputKind = obs_source_get_id(source);
 	OBSDataAutoRelease inputSettings = obs_source_get_settings(source);
 	OBSDataAutoRelease defaultInputSettings = obs_get_source_defaults(inputKind.c_str());
@@ -52,7 +55,7 @@ void EventHandler::HandleInputCreated(obs_source_t *source)
 	eventData["unversionedInputKind"] = obs_source_get_unversioned_id(source);
 	eventData["inputSettings"] = Utils::Json::ObsDataToJson(inputSettings);
 	eventData["defaultInputSettings"] = Utils::Json::ObsDataToJson(defaultInputSettings, true);
-	BroadcastEvent(EventSubscription::Inputs, "InputCreated", eventData);
+	BroadcastEvent(EventSubscription::Inputs, "InputCreated", std::move(eventData));
 }
 
 /**
@@ -70,13 +73,16 @@ void EventHandler::HandleInputCreated(obs_source_t *source)
  */
 void EventHandler::HandleInputRemoved(obs_source_t *source)
 {
+	if (!HasSubscribers(EventSubscription::Inputs))
+		return;
+
 	json eventData;
 	QString s = obs_source_get_name(source);
 	if (s.contains("(tmp)"))
 		return;
 	eventData["inputName"] = obs_source_get_name(source);
 	eventData["inputKind"] = obs_source_get_id(source);
-	BroadcastEvent(EventSubscription::Inputs, "InputRemoved", eventData);
+	BroadcastEvent(EventSubscription::Inputs, "InputRemoved", std::move(eventData));
 }
 
 /**
@@ -95,10 +101,13 @@ void EventHandler::HandleInputRemoved(obs_source_t *source)
  */
 void EventHandler::HandleInputNameChanged(obs_source_t *, std::string oldInputName, std::string inputName)
 {
+	if (!HasSubscribers(EventSubscription::Inputs))
+		return;
+
 	json eventData;
 	eventData["oldInputName"] = oldInputName;
 	eventData["inputName"] = inputName;
-	BroadcastEvent(EventSubscription::Inputs, "InputNameChanged", eventData);
+	BroadcastEvent(EventSubscription::Inputs, "InputNameChanged", std::move(eventData));
 }
 
 /**
@@ -121,7 +130,7 @@ void EventHandler::HandleInputActiveStateChanged(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
-	if (!eventHandler->_inputActiveStateChangedRef.load())
+	if (!eventHandler->HasSubscribers(EventSubscription::InputActiveStateChanged))
 		return;
 
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
@@ -134,7 +143,7 @@ void EventHandler::HandleInputActiveStateChanged(void *param, calldata_t *data)
 	json eventData;
 	eventData["inputName"] = obs_source_get_name(source);
 	eventData["videoActive"] = obs_source_active(source);
-	eventHandler->BroadcastEvent(EventSubscription::InputActiveStateChanged, "InputActiveStateChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::InputActiveStateChanged, "InputActiveStateChanged", std::move(eventData));
 }
 
 /**
@@ -157,7 +166,7 @@ void EventHandler::HandleInputShowStateChanged(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
-	if (!eventHandler->_inputShowStateChangedRef.load())
+	if (!eventHandler->HasSubscribers(EventSubscription::InputShowStateChanged))
 		return;
 
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
@@ -170,7 +179,7 @@ void EventHandler::HandleInputShowStateChanged(void *param, calldata_t *data)
 	json eventData;
 	eventData["inputName"] = obs_source_get_name(source);
 	eventData["videoShowing"] = obs_source_showing(source);
-	eventHandler->BroadcastEvent(EventSubscription::InputShowStateChanged, "InputShowStateChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::InputShowStateChanged, "InputShowStateChanged", std::move(eventData));
 }
 
 /**
@@ -191,6 +200,9 @@ void EventHandler::HandleInputMuteStateChanged(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Inputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -201,7 +213,7 @@ void EventHandler::HandleInputMuteStateChanged(void *param, calldata_t *data)
 	json eventData;
 	eventData["inputName"] = obs_source_get_name(source);
 	eventData["inputMuted"] = obs_source_muted(source);
-	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputMuteStateChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputMuteStateChanged", std::move(eventData));
 }
 
 /**
@@ -223,6 +235,9 @@ void EventHandler::HandleInputVolumeChanged(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Inputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -241,7 +256,7 @@ void EventHandler::HandleInputVolumeChanged(void *param, calldata_t *data)
 	eventData["inputName"] = obs_source_get_name(source);
 	eventData["inputVolumeMul"] = inputVolumeMul;
 	eventData["inputVolumeDb"] = inputVolumeDb;
-	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputVolumeChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputVolumeChanged", std::move(eventData));
 }
 
 /**
@@ -262,6 +277,9 @@ void EventHandler::HandleInputAudioBalanceChanged(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Inputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -274,7 +292,7 @@ void EventHandler::HandleInputAudioBalanceChanged(void *param, calldata_t *data)
 	json eventData;
 	eventData["inputName"] = obs_source_get_name(source);
 	eventData["inputAudioBalance"] = inputAudioBalance;
-	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputAudioBalanceChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputAudioBalanceChanged", std::move(eventData));
 }
 
 /**
@@ -295,6 +313,9 @@ void EventHandler::HandleInputAudioSyncOffsetChanged(void *param, calldata_t *da
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Inputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -307,7 +328,7 @@ void EventHandler::HandleInputAudioSyncOffsetChanged(void *param, calldata_t *da
 	json eventData;
 	eventData["inputName"] = obs_source_get_name(source);
 	eventData["inputAudioSyncOffset"] = inputAudioSyncOffset / 1000000;
-	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputAudioSyncOffsetChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputAudioSyncOffsetChanged", std::move(eventData));
 }
 
 /**
@@ -328,6 +349,9 @@ void EventHandler::HandleInputAudioTracksChanged(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Inputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -345,7 +369,7 @@ void EventHandler::HandleInputAudioTracksChanged(void *param, calldata_t *data)
 	json eventData;
 	eventData["inputName"] = obs_source_get_name(source);
 	eventData["inputAudioTracks"] = inputAudioTracks;
-	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputAudioTracksChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputAudioTracksChanged", std::move(eventData));
 }
 
 /**
@@ -372,6 +396,9 @@ void EventHandler::HandleInputAudioMonitorTypeChanged(void *param, calldata_t *d
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Inputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -384,7 +411,7 @@ void EventHandler::HandleInputAudioMonitorTypeChanged(void *param, calldata_t *d
 	json eventData;
 	eventData["inputName"] = obs_source_get_name(source);
 	eventData["monitorType"] = monitorType;
-	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputAudioMonitorTypeChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Inputs, "InputAudioMonitorTypeChanged", std::move(eventData));
 }
 
 /**
@@ -402,7 +429,10 @@ void EventHandler::HandleInputAudioMonitorTypeChanged(void *param, calldata_t *d
  */
 void EventHandler::HandleInputVolumeMeters(std::vector<json> inputs)
 {
+	if (!HasSubscribers(EventSubscription::InputVolumeMeters))
+		return;
+
 	json eventData;
 	eventData["inputs"] = inputs;
-	BroadcastEvent(EventSubscription::InputVolumeMeters, "InputVolumeMeters", eventData);
+	BroadcastEvent(EventSubscription::InputVolumeMeters, "InputVolumeMeters", std::move(eventData));
 }
@@ -40,6 +40,9 @@ void EventHandler::SourceMediaPauseMultiHandler(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::MediaInputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -54,6 +57,9 @@ void EventHandler::SourceMediaPlayMultiHandler(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::MediaInputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -68,6 +74,9 @@ void EventHandler::SourceMediaRestartMultiHandler(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::MediaInputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -82,6 +91,9 @@ void EventHandler::SourceMediaStopMultiHandler(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::MediaInputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -96,6 +108,9 @@ void EventHandler::SourceMediaNextMultiHandler(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::MediaInputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -110,6 +125,9 @@ void EventHandler::SourceMediaPreviousMultiHandler(void *param, calldata_t *data
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::MediaInputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -137,6 +155,9 @@ void EventHandler::HandleMediaInputPlaybackStarted(void *param, calldata_t *data
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::MediaInputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -146,7 +167,7 @@ void EventHandler::HandleMediaInputPlaybackStarted(void *param, calldata_t *data
 
 	json eventData;
 	eventData["inputName"] = obs_source_get_name(source);
-	eventHandler->BroadcastEvent(EventSubscription::MediaInputs, "MediaInputPlaybackStarted", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::MediaInputs, "MediaInputPlaybackStarted", std::move(eventData));
 }
 
 /**
@@ -166,6 +187,9 @@ void EventHandler::HandleMediaInputPlaybackEnded(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::MediaInputs))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
@@ -175,7 +199,7 @@ void EventHandler::HandleMediaInputPlaybackEnded(void *param, calldata_t *data)
 
 	json eventData;
 	eventData["inputName"] = obs_source_get_name(source);
-	eventHandler->BroadcastEvent(EventSubscription::MediaInputs, "MediaInputPlaybackEnded", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::MediaInputs, "MediaInputPlaybackEnded", std::move(eventData));
 }
 
 /**
@@ -197,5 +221,5 @@ void EventHandler::HandleMediaInputActionTriggered(obs_source_t *source, ObsMedi
 	json eventData;
 	eventData["inputName"] = obs_source_get_name(source);
 	eventData["mediaAction"] = GetMediaInputActionString(action);
-	BroadcastEvent(EventSubscription::MediaInputs, "MediaInputActionTriggered", eventData);
+	BroadcastEvent(EventSubscription::MediaInputs, "MediaInputActionTriggered", std::move(eventData));
 }
\ No newline at end of file
@@ -51,14 +51,20 @@ static bool GetOutputStateActive(ObsOutputState state)
  */
 void EventHandler::HandleStreamStateChanged(ObsOutputState state)
 {
+	if (!HasSubscribers(EventSubscription::Outputs))
+		return;
+
 	json eventData;
 	eventData["outputActive"] = GetOutputStateActive(state);
 	eventData["outputState"] = state;
-	BroadcastEvent(EventSubscription::Outputs, "StreamStateChanged", eventData);
+	BroadcastEvent(EventSubscription::Outputs, "StreamStateChanged", std::move(eventData));
 }
 
 void EventHandler::HandleStreamServiceAddressUpdated()
 {
+	if (!HasSubscribers(EventSubscription::Outputs))
+		return;
+
 	json eventData;
 
 	OBSService service = obs_frontend_get_streaming_service();
@@ -66,7 +72,7 @@ void EventHandler::HandleStreamServiceAddressUpdated()
 	OBSDataAutoRelease serviceSettings = obs_service_get_settings(service);
 	eventData["streamServiceSettings"] = Utils::Json::ObsDataToJson(serviceSettings, true);
 
-	BroadcastEvent(EventSubscription::Outputs, "StreamServiceAddressUpdated", eventData);
+	BroadcastEvent(EventSubscription::Outputs, "StreamServiceAddressUpdated", std::move(eventData));
 }
 
 /**
@@ -86,6 +92,9 @@ void EventHandler::HandleStreamServiceAddressUpdated()
  */
 void EventHandler::HandleRecordStateChanged(ObsOutputState state)
 {
+	if (!HasSubscribers(EventSubscription::Outputs))
+		return;
+
 	json eventData;
 	eventData["outputActive"] = GetOutputStateActive(state);
 	eventData["outputState"] = state;
@@ -94,7 +103,7 @@ void EventHandler::HandleRecordStateChanged(ObsOutputState state)
 	} else {
 		eventData["outputPath"] = nullptr;
 	}
-	BroadcastEvent(EventSubscription::Outputs, "RecordStateChanged", eventData);
+	BroadcastEvent(EventSubscription::Outputs, "RecordStateChanged", std::move(eventData));
 }
 
 /**
@@ -113,10 +122,13 @@ void EventHandler::HandleRecordStateChanged(ObsOutputState state)
  */
 void EventHandler::HandleReplayBufferStateChanged(ObsOutputState state)
 {
+	if (!HasSubscribers(EventSubscription::Outputs))
+		return;
+
 	json eventData;
 	eventData["outputActive"] = GetOutputStateActive(state);
 	eventData["outputState"] = state;
-	BroadcastEvent(EventSubscription::Outputs, "ReplayBufferStateChanged", eventData);
+	BroadcastEvent(EventSubscription::Outputs, "ReplayBufferStateChanged", std::move(eventData));
 }
 
 /**
@@ -135,10 +147,13 @@ void EventHandler::HandleReplayBufferStateChanged(ObsOutputState state)
  */
 void EventHandler::HandleVirtualcamStateChanged(ObsOutputState state)
 {
+	if (!HasSubscribers(EventSubscription::Outputs))
+		return;
+
 	json eventData;
 	eventData["outputActive"] = GetOutputStateActive(state);
 	eventData["outputState"] = state;
-	BroadcastEvent(EventSubscription::Outputs, "VirtualcamStateChanged", eventData);
+	BroadcastEvent(EventSubscription::Outputs, "VirtualcamStateChanged", std::move(eventData));
 }
 
 /**
@@ -156,7 +171,10 @@ void EventHandler::HandleVirtualcamStateChanged(ObsOutputState state)
  */
 void EventHandler::HandleReplayBufferSaved()
 {
+	if (!HasSubscribers(EventSubscription::Outputs))
+		return;
+
 	json eventData;
 	eventData["savedReplayPath"] = Utils::Obs::StringHelper::GetLastReplayBufferFileName();
-	BroadcastEvent(EventSubscription::Outputs, "ReplayBufferSaved", eventData);
+	BroadcastEvent(EventSubscription::Outputs, "ReplayBufferSaved", std::move(eventData));
 }
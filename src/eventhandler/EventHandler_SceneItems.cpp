@@ -39,6 +39,9 @@ void EventHandler::HandleSceneItemCreated(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::SceneItems))
+		return;
+
 	obs_scene_t *scene = GetCalldataPointer<obs_scene_t>(data, "scene");
 	if (!scene)
 		return;
@@ -52,7 +55,7 @@ void EventHandler::HandleSceneItemCreated(void *param, calldata_t *data)
 	eventData["sourceName"] = obs_source_get_name(obs_sceneitem_get_source(sceneItem));
 	eventData["sceneItemId"] = obs_sceneitem_get_id(sceneItem);
 	eventData["sceneItemIndex"] = obs_sceneitem_get_order_position(sceneItem);
-	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemCreated", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemCreated", std::move(eventData));
 }
 
 /**
@@ -76,6 +79,9 @@ void EventHandler::HandleSceneItemRemoved(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::SceneItems))
+		return;
+
 	obs_scene_t *scene = GetCalldataPointer<obs_scene_t>(data, "scene");
 	if (!scene)
 		return;
@@ -88,7 +94,7 @@ void EventHandler::HandleSceneItemRemoved(void *param, calldata_t *data)
 	/*eventData["sceneName"] = obs_source_get_name(obs_scene_get_source(scene));
 	eventData["sourceName"] = obs_source_get_name(obs_sceneitem_get_source(sceneItem));
 	eventData["sceneItemId"] = obs_sceneitem_get_id(sceneItem);*/
-	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemRemoved", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemRemoved", std::move(eventData));
 }
 
 /**
@@ -109,6 +115,9 @@ void EventHandler::HandleSceneItemListReindexed(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::SceneItems))
+		return;
+
 	obs_scene_t *scene = GetCalldataPointer<obs_scene_t>(data, "scene");
 	if (!scene)
 		return;
@@ -116,7 +125,7 @@ void EventHandler::HandleSceneItemListReindexed(void *param, calldata_t *data)
 	json eventData;
 	eventData["sceneName"] = obs_source_get_name(obs_scene_get_source(scene));
 	eventData["sceneItems"] = Utils::Obs::ArrayHelper::GetSceneItemList(scene, true);
-	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemListReindexed", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemListReindexed", std::move(eventData));
 }
 
 /**
@@ -138,6 +147,9 @@ void EventHandler::HandleSceneItemEnableStateChanged(void *param, calldata_t *da
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::SceneItems))
+		return;
+
 	obs_scene_t *scene = GetCalldataPointer<obs_scene_t>(data, "scene");
 	if (!scene)
 		return;
@@ -152,7 +164,7 @@ void EventHandler::HandleSceneItemEnableStateChanged(void *param, calldata_t *da
 	eventData["sceneName"] = obs_source_get_name(obs_scene_get_source(scene));
 	eventData["sceneItemId"] = obs_sceneitem_get_id(sceneItem);
 	eventData["sceneItemEnabled"] = sceneItemEnabled;
-	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemEnableStateChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemEnableStateChanged", std::move(eventData));
 }
 
 /**
@@ -174,6 +186,9 @@ void EventHandler::HandleSceneItemLockStateChanged(void *param, calldata_t *data
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::SceneItems))
+		return;
+
 	obs_scene_t *scene = GetCalldataPointer<obs_scene_t>(data, "scene");
 	if (!scene)
 		return;
@@ -188,7 +203,7 @@ void EventHandler::HandleSceneItemLockStateChanged(void *param, calldata_t *data
 	eventData["sceneName"] = obs_source_get_name(obs_scene_get_source(scene));
 	eventData["sceneItemId"] = obs_sceneitem_get_id(sceneItem);
 	eventData["sceneItemLocked"] = sceneItemLocked;
-	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemLockStateChanged", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemLockStateChanged", std::move(eventData));
 }
 
 /**
@@ -209,6 +224,9 @@ void EventHandler::HandleSceneItemSelected(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::SceneItems))
+		return;
+
 	obs_scene_t *scene = GetCalldataPointer<obs_scene_t>(data, "scene");
 	if (!scene)
 		return;
@@ -220,12 +238,14 @@ void EventHandler::HandleSceneItemSelected(void *param, calldata_t *data)
 	json eventData;
 	eventData["sceneName"] = obs_source_get_name(obs_scene_get_source(scene));
 	eventData["sceneItemId"] = obs_sceneitem_get_id(sceneItem);
-	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemSelected", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::SceneItems, "SceneItemSelected", std::move(eventData));
 }
 
 /**
  * The transform/crop of a scene item has changed.
  *
+ * Sent at most once per video frame for each scene item, with the latest transform. Clients can lower this further with `sceneItemTransformInterval` in `Identify`/`Reidentify`.
+ *
  * @dataField sceneName          | String | The name of the scene the item is in
  * @dataField sceneItemId        | Number | Numeric ID of the scene item
  * @dataField sceneItemTransform | Object | New transform/crop info of the scene item
@@ -242,7 +262,7 @@ void EventHandler::HandleSceneItemTransformChanged(void *param, calldata_t *data
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
-	if (!eventHandler->_sceneItemTransformChangedRef.load())
+	if (!eventHandler->HasSubscribers(EventSubscription::SceneItemTransformChanged))
 		return;
 
 	obs_scene_t *scene = GetCalldataPointer<obs_scene_t>(data, "scene");
@@ -253,9 +273,63 @@ void EventHandler::HandleSceneItemTransformChanged(void *param, calldata_t *data
 	if (!sceneItem)
 		return;
 
-	json eventData;
-	eventData["sceneName"] = obs_source_get_name(obs_scene_get_source(scene));
-	eventData["sceneItemId"] = obs_sceneitem_get_id(sceneItem);
-	eventData["sceneItemTransform"] = Utils::Obs::ObjectHelper::GetSceneItemTransform(sceneItem);
-	eventHandler->BroadcastEvent(EventSubscription::SceneItemTransformChanged, "SceneItemTransformChanged", eventData);
+	// Only mark the scene item as changed. The transform is read and sent on the next video frame.
+	obs_source_t *sceneSource = obs_scene_get_source(scene);
+	auto key = std::make_pair(sceneSource, obs_sceneitem_get_id(sceneItem));
+
+	std::unique_lock<std::mutex> lock(eventHandler->_pendingSceneItemTransformsMutex);
+	if (eventHandler->_pendingSceneItemTransforms.count(key))
+		return;
+	eventHandler->_pendingSceneItemTransforms[key] = obs_source_get_weak_source(sceneSource);
+}
+
+// Graphics thread tick. Sends one SceneItemTransformChanged for every scene item changed since the last frame.
+void EventHandler::SceneItemTransformTick(void *param, float)
+{
+	auto eventHandler = static_cast<EventHandler *>(param);
+
+	// Changes from before a scene collection change are of no use after it
+	if (!eventHandler->HasSubscribers(EventSubscription::SceneItemTransformChanged)) {
+		eventHandler->ClearPendingSceneItemTransforms();
+		return;
+	}
+
+	std::map<std::pair<obs_source_t *, int64_t>, obs_weak_source_t *> pendingSceneItemTransforms;
+	{
+		std::unique_lock<std::mutex> lock(eventHandler->_pendingSceneItemTransformsMutex);
+		if (eventHandler->_pendingSceneItemTransforms.empty())
+			return;
+		pendingSceneItemTransforms.swap(eventHandler->_pendingSceneItemTransforms);
+	}
+
+	for (auto &[key, weakSceneSource] : pendingSceneItemTransforms) {
+		OBSWeakSourceAutoRelease weakScene = weakSceneSource;
+		OBSSourceAutoRelease sceneSource = obs_weak_source_get_source(weakScene);
+		if (!sceneSource)
+			continue;
+
+		obs_scene_t *scene = obs_group_or_scene_from_source(sceneSource);
+		if (!scene)
+			continue;
+
+		// Removed since the transform changed
+		OBSSceneItem sceneItem = obs_scene_find_sceneitem_by_id(scene, key.second);
+		if (!sceneItem)
+			continue;
+
+		json eventData;
+		eventData["sceneName"] = obs_source_get_name(sceneSource);
+		eventData["sceneItemId"] = key.second;
+		eventData["sceneItemTransform"] = Utils::Obs::ObjectHelper::GetSceneItemTransform(sceneItem);
+		eventHandler->BroadcastEvent(EventSubscription::SceneItemTransformChanged, "SceneItemTransformChanged",
+					     std::move(eventData));
+	}
+}
+
+void EventHandler::ClearPendingSceneItemTransforms()
+{
+	std::unique_lock<std::mutex> lock(_pendingSceneItemTransformsMutex);
+	for (auto &[key, weakSceneSource] : _pendingSceneItemTransforms)
+		obs_weak_source_release(weakSceneSource);
+	_pendingSceneItemTransforms.clear();
 }
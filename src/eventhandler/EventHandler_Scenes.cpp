@@ -35,10 +35,13 @@ with this program. If not, see <https://www.gnu.org/licenses/>
  */
 void EventHandler::HandleSceneCreated(obs_source_t *source)
 {
+	if (!HasSubscribers(EventSubscription::Scenes))
+		return;
+
 	json eventData;
 	eventData["sceneName"] = obs_source_get_name(source);
 	eventData["isGroup"] = obs_source_is_group(source);
-	BroadcastEvent(EventSubscription::Scenes, "SceneCreated", eventData);
+	BroadcastEvent(EventSubscription::Scenes, "SceneCreated", std::move(eventData));
 }
 
 /**
@@ -57,10 +60,13 @@ void EventHandler::HandleSceneCreated(obs_source_t *source)
  */
 void EventHandler::HandleSceneRemoved(obs_source_t *source)
 {
+	if (!HasSubscribers(EventSubscription::Scenes))
+		return;
+
 	json eventData;
 	eventData["sceneName"] = obs_source_get_name(source);
 	eventData["isGroup"] = obs_source_is_group(source);
-	BroadcastEvent(EventSubscription::Scenes, "SceneRemoved", eventData);
+	BroadcastEvent(EventSubscription::Scenes, "SceneRemoved", std::move(eventData));
 }
 
 /**
@@ -79,10 +85,13 @@ void EventHandler::HandleSceneRemoved(obs_source_t *source)
  */
 void EventHandler::HandleSceneNameChanged(obs_source_t *, std::string oldSceneName, std::string sceneName)
 {
+	if (!HasSubscribers(EventSubscription::Scenes))
+		return;
+
 	json eventData;
 	eventData["oldSceneName"] = oldSceneName;
 	eventData["sceneName"] = sceneName;
-	BroadcastEvent(EventSubscription::Scenes, "SceneNameChanged", eventData);
+	BroadcastEvent(EventSubscription::Scenes, "SceneNameChanged", std::move(eventData));
 }
 
 /**
@@ -100,11 +109,14 @@ void EventHandler::HandleSceneNameChanged(obs_source_t *, std::string oldSceneNa
  */
 void EventHandler::HandleCurrentProgramSceneChanged()
 {
+	if (!HasSubscribers(EventSubscription::Scenes))
+		return;
+
 	OBSSourceAutoRelease currentScene = obs_frontend_get_current_scene();
 
 	json eventData;
 	eventData["sceneName"] = obs_source_get_name(currentScene);
-	BroadcastEvent(EventSubscription::Scenes, "CurrentProgramSceneChanged", eventData);
+	BroadcastEvent(EventSubscription::Scenes, "CurrentProgramSceneChanged", std::move(eventData));
 }
 
 /**
@@ -122,6 +134,9 @@ void EventHandler::HandleCurrentProgramSceneChanged()
  */
 void EventHandler::HandleCurrentPreviewSceneChanged()
 {
+	if (!HasSubscribers(EventSubscription::Scenes))
+		return;
+
 	OBSSourceAutoRelease currentPreviewScene = obs_frontend_get_current_preview_scene();
 
 	// This event may be called when OBS is not in studio mode, however retreiving the source while not in studio mode will return null.
@@ -130,7 +145,7 @@ void EventHandler::HandleCurrentPreviewSceneChanged()
 
 	json eventData;
 	eventData["sceneName"] = obs_source_get_name(currentPreviewScene);
-	BroadcastEvent(EventSubscription::Scenes, "CurrentPreviewSceneChanged", eventData);
+	BroadcastEvent(EventSubscription::Scenes, "CurrentPreviewSceneChanged", std::move(eventData));
 }
 
 /**
@@ -150,7 +165,10 @@ void EventHandler::HandleCurrentPreviewSceneChanged()
  */
 void EventHandler::HandleSceneListChanged()
 {
+	if (!HasSubscribers(EventSubscription::Scenes))
+		return;
+
 	json eventData;
 	eventData["scenes"] = Utils::Obs::ArrayHelper::GetSceneList();
-	BroadcastEvent(EventSubscription::Scenes, "SceneListChanged", eventData);
+	BroadcastEvent(EventSubscription::Scenes, "SceneListChanged", std::move(eventData));
 }
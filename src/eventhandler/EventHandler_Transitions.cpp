@@ -34,11 +34,14 @@ with this program. If not, see <https://www.gnu.org/licenses/>
  */
 void EventHandler::HandleCurrentSceneTransitionChanged()
 {
+	if (!HasSubscribers(EventSubscription::Transitions))
+		return;
+
 	OBSSourceAutoRelease transition = obs_frontend_get_current_transition();
 
 	json eventData;
 	eventData["transitionName"] = obs_source_get_name(transition);
-	BroadcastEvent(EventSubscription::Transitions, "CurrentSceneTransitionChanged", eventData);
+	BroadcastEvent(EventSubscription::Transitions, "CurrentSceneTransitionChanged", std::move(eventData));
 }
 
 /**
@@ -56,9 +59,12 @@ void EventHandler::HandleCurrentSceneTransitionChanged()
  */
 void EventHandler::HandleCurrentSceneTransitionDurationChanged()
 {
+	if (!HasSubscribers(EventSubscription::Transitions))
+		return;
+
 	json eventData;
 	eventData["transitionDuration"] = obs_frontend_get_transition_duration();
-	BroadcastEvent(EventSubscription::Transitions, "CurrentSceneTransitionDurationChanged", eventData);
+	BroadcastEvent(EventSubscription::Transitions, "CurrentSceneTransitionDurationChanged", std::move(eventData));
 }
 
 /**
@@ -78,13 +84,16 @@ void EventHandler::HandleSceneTransitionStarted(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Transitions))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
 
 	json eventData;
 	eventData["transitionName"] = obs_source_get_name(source);
-	eventHandler->BroadcastEvent(EventSubscription::Transitions, "SceneTransitionStarted", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Transitions, "SceneTransitionStarted", std::move(eventData));
 }
 
 /**
@@ -106,13 +115,16 @@ void EventHandler::HandleSceneTransitionEnded(void *param, calldata_t *data)
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Transitions))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
 
 	json eventData;
 	eventData["transitionName"] = obs_source_get_name(source);
-	eventHandler->BroadcastEvent(EventSubscription::Transitions, "SceneTransitionEnded", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Transitions, "SceneTransitionEnded", std::move(eventData));
 }
 
 /**
@@ -137,11 +149,14 @@ void EventHandler::HandleSceneTransitionVideoEnded(void *param, calldata_t *data
 {
 	auto eventHandler = static_cast<EventHandler *>(param);
 
+	if (!eventHandler->HasSubscribers(EventSubscription::Transitions))
+		return;
+
 	obs_source_t *source = GetCalldataPointer<obs_source_t>(data, "source");
 	if (!source)
 		return;
 
 	json eventData;
 	eventData["transitionName"] = obs_source_get_name(source);
-	eventHandler->BroadcastEvent(EventSubscription::Transitions, "SceneTransitionVideoEnded", eventData);
+	eventHandler->BroadcastEvent(EventSubscription::Transitions, "SceneTransitionVideoEnded", std::move(eventData));
 }
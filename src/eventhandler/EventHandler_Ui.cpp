@@ -34,7 +34,10 @@ with this program. If not, see <https://www.gnu.org/licenses/>
  */
 void EventHandler::HandleStudioModeStateChanged(bool enabled)
 {
+	if (!HasSubscribers(EventSubscription::Ui))
+		return;
+
 	json eventData;
 	eventData["studioModeEnabled"] = enabled;
-	BroadcastEvent(EventSubscription::Ui, "StudioModeStateChanged", eventData);
+	BroadcastEvent(EventSubscription::Ui, "StudioModeStateChanged", std::move(eventData));
 }
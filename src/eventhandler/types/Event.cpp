@@ -0,0 +1,95 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <obs.h>
+#include <util/platform.h>
+
+#include "Event.h"
+
+Event::Event(uint64_t requiredIntent, std::string eventType, json eventData, uint8_t rpcVersion)
+	: _requiredIntent(requiredIntent),
+	  _eventType(std::move(eventType)),
+	  _rpcVersion(rpcVersion),
+	  _createdAt(os_gettime_ns()),
+	  _videoFrame(obs_get_total_frames()),
+	  _sequence(0),
+	  _queuedAt(0),
+	  _sentAt(0)
+{
+	_message["op"] = 5;
+	_message["d"]["eventType"] = _eventType;
+	_message["d"]["eventIntent"] = _requiredIntent;
+	if (eventData.is_object())
+		_message["d"]["eventData"] = std::move(eventData);
+}
+
+void Event::SetSequence(uint64_t sequence)
+{
+	_sequence = sequence;
+	_message["d"]["eventSequence"] = sequence;
+}
+
+void Event::SetDispatchTimes(uint64_t queuedAt, uint64_t sentAt)
+{
+	_queuedAt = queuedAt;
+	_sentAt = sentAt;
+}
+
+std::shared_ptr<Event> Event::WithEventData(json eventData) const
+{
+	auto ret = std::make_shared<Event>(_requiredIntent, _eventType, std::move(eventData), _rpcVersion);
+	ret->_createdAt = _createdAt;
+	ret->_videoFrame = _videoFrame;
+	if (_sequence)
+		ret->SetSequence(_sequence);
+	ret->SetDispatchTimes(_queuedAt, _sentAt);
+	return ret;
+}
+
+json Event::MessageWithTimestamps() const
+{
+	json ret = _message;
+	auto &timestamps = ret["d"]["eventTimestamps"];
+	timestamps["emittedAt"] = _createdAt;
+	timestamps["videoFrame"] = _videoFrame;
+	timestamps["queuedAt"] = _queuedAt;
+	timestamps["sentAt"] = _sentAt;
+	return ret;
+}
+
+const json &Event::EventData() const
+{
+	static const json nullData;
+
+	auto &messageData = _message["d"];
+	auto it = messageData.find("eventData");
+	return it != messageData.end() ? *it : nullData;
+}
+
+MessagePtr Event::GetSerializedMessage(uint8_t encoding, Serializer serialize, bool withTimestamps) const
+{
+	if (encoding >= _serializedMessages[0].size())
+		return withTimestamps ? serialize(MessageWithTimestamps(), encoding) : serialize(_message, encoding);
+
+	std::lock_guard<std::mutex> lock(_serializedMessagesMutex);
+	auto &ret = _serializedMessages[withTimestamps][encoding];
+	if (!ret)
+		ret = withTimestamps ? serialize(MessageWithTimestamps(), encoding) : serialize(_message, encoding);
+	return ret;
+}
@@ -0,0 +1,82 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <websocketpp/config/asio_no_tls.hpp>
+
+#include "../../utils/Json.h"
+
+// A framed outgoing message, which can be shared by any number of connections
+typedef websocketpp::config::asio::message_type::ptr MessagePtr;
+
+class Event;
+typedef std::shared_ptr<const Event> EventPtr;
+
+// Event envelope, built once by whatever emits the event and then only passed around by reference. The event data is
+// moved into the complete `Event` (op 5) message on construction, and each encoding is serialized at most once. The
+// event dispatcher stamps the sequence number and dispatch times before handing the envelope out, after which it is
+// immutable.
+class Event {
+public:
+	typedef MessagePtr (*Serializer)(const json &message, uint8_t encoding);
+
+	Event(uint64_t requiredIntent, std::string eventType, json eventData = nullptr, uint8_t rpcVersion = 0);
+
+	uint64_t RequiredIntent() const { return _requiredIntent; }
+	const std::string &EventType() const { return _eventType; }
+	uint8_t RpcVersion() const { return _rpcVersion; }
+	uint64_t CreatedAt() const { return _createdAt; }
+	uint32_t VideoFrame() const { return _videoFrame; }
+	uint64_t Sequence() const { return _sequence; }
+	void SetSequence(uint64_t sequence);
+	// When the event entered the dispatcher queue, and when the dispatcher handed it to the connections
+	void SetDispatchTimes(uint64_t queuedAt, uint64_t sentAt);
+
+	// The same event with other event data, eg. narrowed down for one session
+	std::shared_ptr<Event> WithEventData(json eventData) const;
+
+	// Null if the event has no data
+	const json &EventData() const;
+	const json &Message() const { return _message; }
+
+	// Serializes `Message()` with `serialize` on first use, then returns the same framed message for every caller.
+	// `withTimestamps` adds the `eventTimestamps` object, for sessions which asked for it.
+	MessagePtr GetSerializedMessage(uint8_t encoding, Serializer serialize, bool withTimestamps = false) const;
+
+private:
+	uint64_t _requiredIntent;
+	std::string _eventType;
+	uint8_t _rpcVersion;
+	uint64_t _createdAt;
+	uint32_t _videoFrame;
+	uint64_t _sequence;
+	uint64_t _queuedAt;
+	uint64_t _sentAt;
+	json _message;
+
+	json MessageWithTimestamps() const;
+
+	mutable std::mutex _serializedMessagesMutex;
+	mutable std::array<std::array<MessagePtr, 2>, 2> _serializedMessages; // Indexed by timestamps, then WebSocketEncoding
+};
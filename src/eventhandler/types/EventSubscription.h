@@ -210,4 +210,6 @@ namespace EventSubscription {
 		*/
 		SceneItemTransformChanged = (1 << 19),
 	};
+
+	inline bool IsHighVolume(uint64_t eventSubscription) { return (eventSubscription & ~(uint64_t)All) != 0; }
 }
@@ -177,6 +177,9 @@ void SettingsDialog::SaveFormData()
 		}
 	}
 
+	bool authenticationChanged = (conf->AuthRequired != ui->enableAuthenticationCheckBox->isChecked()) ||
+				     (conf->ServerPassword != ui->serverPasswordLineEdit->text());
+
 	bool needsRestart =
 		(conf->ServerEnabled != ui->enableWebSocketServerCheckBox->isChecked()) ||
 		(conf->ServerPort != ui->serverPortSpinBox->value()) ||
@@ -194,6 +197,12 @@ void SettingsDialog::SaveFormData()
 	RefreshData();
 	connectInfo->RefreshData();
 
+	// Suspended sessions would resume without authenticating against the new settings
+	if (authenticationChanged) {
+		auto server = GetWebSocketServer();
+		server->ClearSuspendedSessions();
+	}
+
 	if (needsRestart) {
 		blog(LOG_INFO, "[SettingsDialog::SaveFormData] A setting was changed which requires a server restart.");
 		auto server = GetWebSocketServer();
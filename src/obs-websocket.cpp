@@ -173,9 +173,10 @@ void WebSocketApiEventCallback(std::string vendorName, std::string eventType, ob
 	json broadcastEventData;
 	broadcastEventData["vendorName"] = vendorName;
 	broadcastEventData["eventType"] = eventType;
-	broadcastEventData["eventData"] = eventData;
+	broadcastEventData["eventData"] = std::move(eventData);
 
-	_webSocketServer->BroadcastEvent(EventSubscription::Vendors, "VendorEvent", broadcastEventData);
+	_webSocketServer->BroadcastEvent(
+		std::make_shared<Event>(EventSubscription::Vendors, "VendorEvent", std::move(broadcastEventData)));
 }
 
 #ifdef PLUGIN_TESTS
@@ -17,13 +17,14 @@ You should have received a copy of the GNU General Public License along
 with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
+#include <iterator>
 #ifdef PLUGIN_TESTS
 #include <util/profiler.hpp>
 #endif
 
 #include "RequestHandler.h"
 
-const std::unordered_map<std::string, RequestMethodHandler> RequestHandler::_handlerMap{
+constexpr RequestType RequestHandler::_requestTypes[]{
 	// Lost + Extra
 	{"SetRecordDirectory", &RequestHandler::SetRecordDirectory},
 	{"GetFilenameFormatting", &RequestHandler::GetFilenameFormatting},
@@ -43,6 +44,7 @@ const std::unordered_map<std::string, RequestMethodHandler> RequestHandler::_han
 	// General
 	{"GetVersion", &RequestHandler::GetVersion},
 	{"GetStats", &RequestHandler::GetStats},
+	{"GetRequestStats", &RequestHandler::GetRequestStats},
 	{"BroadcastCustomEvent", &RequestHandler::BroadcastCustomEvent},
 	{"CallVendorRequest", &RequestHandler::CallVendorRequest},
 	{"GetHotkeyList", &RequestHandler::GetHotkeyList},
@@ -208,6 +210,63 @@ const std::unordered_map<std::string, RequestMethodHandler> RequestHandler::_han
 	{"OpenSourceProjector", &RequestHandler::OpenSourceProjector},
 };
 
+// A seed for which no two request types share a slot is searched for at compile time, starting from one known to work for the
+// current table. The search only takes more than one attempt when request types are added or renamed.
+static constexpr uint32_t RequestTypeHashSeedHint = 31;
+static constexpr uint32_t RequestTypeHashSeedAttempts = 4096;
+
+// FNV-1a, with the seed mixed into the offset basis
+static constexpr size_t HashRequestType(std::string_view requestType, uint32_t seed, size_t slotCount)
+{
+	uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+	for (char c : requestType) {
+		hash ^= (uint8_t)c;
+		hash *= 16777619u;
+	}
+	hash ^= hash >> 16;
+	return hash & (slotCount - 1);
+}
+
+template<size_t N, size_t SlotCount>
+static constexpr bool IsPerfectRequestTypeHashSeed(const RequestType (&requestTypes)[N], uint32_t seed)
+{
+	bool used[SlotCount] = {};
+	for (auto &requestType : requestTypes) {
+		size_t slot = HashRequestType(requestType.name, seed, SlotCount);
+		if (used[slot])
+			return false;
+		used[slot] = true;
+	}
+	return true;
+}
+
+template<size_t N, size_t SlotCount> static constexpr uint32_t FindRequestTypeHashSeed(const RequestType (&requestTypes)[N])
+{
+	static_assert((SlotCount & (SlotCount - 1)) == 0, "The request type slot count must be a power of two.");
+	for (uint32_t seed = RequestTypeHashSeedHint; seed < RequestTypeHashSeedHint + RequestTypeHashSeedAttempts; seed++)
+		if (IsPerfectRequestTypeHashSeed<N, SlotCount>(requestTypes, seed))
+			return seed;
+	// Only reachable during constant evaluation, where it fails the build
+	throw "No perfect hash seed found for the request type table. Is a request type listed twice?";
+}
+
+template<size_t N, size_t SlotCount>
+static constexpr std::array<uint8_t, SlotCount> BuildRequestTypeSlots(const RequestType (&requestTypes)[N], uint32_t seed)
+{
+	static_assert(N < UINT8_MAX, "Request type IDs no longer fit into a slot.");
+	std::array<uint8_t, SlotCount> ret{};
+	for (size_t i = 0; i < N; i++)
+		ret[HashRequestType(requestTypes[i].name, seed, SlotCount)] = (uint8_t)(i + 1);
+	return ret;
+}
+
+constexpr size_t RequestHandler::_requestTypeCount = std::size(_requestTypes);
+constexpr uint32_t RequestHandler::_requestTypeHashSeed =
+	FindRequestTypeHashSeed<_requestTypeCount, RequestTypeSlotCount>(_requestTypes);
+constexpr std::array<uint8_t, RequestHandler::RequestTypeSlotCount> RequestHandler::_requestTypeSlots =
+	BuildRequestTypeSlots<_requestTypeCount, RequestTypeSlotCount>(_requestTypes, _requestTypeHashSeed);
+RequestTypeStats RequestHandler::_requestTypeStats[_requestTypeCount];
+
 RequestHandler::RequestHandler(SessionPtr session) : _session(session) {}
 
 RequestResult RequestHandler::ProcessRequest(const Request &request)
@@ -222,23 +281,32 @@ RequestResult RequestHandler::ProcessRequest(const Request &request)
 	if (request.RequestType.empty())
 		return RequestResult::Error(RequestStatus::MissingRequestType, "Your request's `requestType` may not be empty.");
 
-	RequestMethodHandler handler;
-	try {
-		handler = _handlerMap.at(request.RequestType);
-	} catch (const std::out_of_range &oor) {
-		UNUSED_PARAMETER(oor);
+	int requestTypeId = GetRequestTypeId(request.RequestType);
+	if (requestTypeId < 0)
 		return RequestResult::Error(RequestStatus::UnknownRequestType, "Your request type is not valid.");
-	}
 
-	return std::bind(handler, this, std::placeholders::_1)(request);
+	uint64_t startTime = os_gettime_ns();
+	RequestResult ret = (this->*_requestTypes[requestTypeId].handler)(request);
+	_requestTypeStats[requestTypeId].Record(os_gettime_ns() - startTime, ret.StatusCode != RequestStatus::Success);
+
+	return ret;
 }
 
 std::vector<std::string> RequestHandler::GetRequestList()
 {
 	std::vector<std::string> ret;
-	for (auto const &[key, val] : _handlerMap) {
-		ret.push_back(key);
+	for (auto &requestType : _requestTypes) {
+		ret.emplace_back(requestType.name);
 	}
 
 	return ret;
 }
+
+int RequestHandler::GetRequestTypeId(std::string_view requestType)
+{
+	uint8_t slot = _requestTypeSlots[HashRequestType(requestType, _requestTypeHashSeed, RequestTypeSlotCount)];
+	if (!slot || _requestTypes[slot - 1].name != requestType)
+		return -1;
+
+	return slot - 1;
+}
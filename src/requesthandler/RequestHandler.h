@@ -19,12 +19,15 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #pragma once
 
-#include <unordered_map>
+#include <array>
+#include <string_view>
 #include <obs.hpp>
 #include <obs-frontend-api.h>
 
 #include "rpc/Request.h"
+#include "rpc/RequestArgs.h"
 #include "rpc/RequestResult.h"
+#include "RequestTypeStats.h"
 #include "types/RequestStatus.h"
 #include "types/RequestBatchExecutionType.h"
 #include "../websocketserver/rpc/WebSocketSession.h"
@@ -35,12 +38,20 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 class RequestHandler;
 typedef RequestResult (RequestHandler::*RequestMethodHandler)(const Request &);
 
+// Entry of the request type table. The index of an entry is the ID of its request type.
+struct RequestType {
+	std::string_view name;
+	RequestMethodHandler handler;
+};
+
 class RequestHandler {
 public:
 	RequestHandler(SessionPtr session = nullptr);
 
 	RequestResult ProcessRequest(const Request &request);
 	std::vector<std::string> GetRequestList();
+	// Dense ID of `requestType`, or -1 if it is not a known request type
+	static int GetRequestTypeId(std::string_view requestType);
 
 private:
 	void ToggleInputsMute(bool mute, obs_source_t *source);
@@ -64,6 +75,7 @@ private:
 	// General
 	RequestResult GetVersion(const Request &);
 	RequestResult GetStats(const Request &);
+	RequestResult GetRequestStats(const Request &);
 	RequestResult BroadcastCustomEvent(const Request &);
 	RequestResult CallVendorRequest(const Request &);
 	RequestResult GetHotkeyList(const Request &);
@@ -229,5 +241,13 @@ private:
 	RequestResult OpenSourceProjector(const Request &);
 
 	SessionPtr _session;
-	static const std::unordered_map<std::string, RequestMethodHandler> _handlerMap;
+
+	// Request types are looked up through a perfect hash built at compile time from `_requestTypes`. Each slot holds the
+	// ID of the request type hashing to it plus one, or 0 if it is empty.
+	static constexpr size_t RequestTypeSlotCount = 4096;
+	static const RequestType _requestTypes[];
+	static const size_t _requestTypeCount;
+	static const uint32_t _requestTypeHashSeed;
+	static const std::array<uint8_t, RequestTypeSlotCount> _requestTypeSlots;
+	static RequestTypeStats _requestTypeStats[]; // Indexed by request type ID
 };
@@ -23,6 +23,7 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #include "RequestHandler.h"
 #include "../websocketserver/WebSocketServer.h"
+#include "../eventhandler/EventHandler.h"
 #include "../eventhandler/types/EventSubscription.h"
 #include "../WebSocketApi.h"
 #include "../obs-websocket.h"
@@ -80,6 +81,9 @@ RequestResult RequestHandler::GetVersion(const Request &)
  * @responseField outputTotalFrames                | Number | Total number of frames outputted by the output thread
  * @responseField webSocketSessionIncomingMessages | Number | Total number of messages received by obs-websocket from the client
  * @responseField webSocketSessionOutgoingMessages | Number | Total number of messages sent by obs-websocket to the client
+ * @responseField eventQueueDepth                  | Number | Number of events waiting to be sent by the event dispatcher
+ * @responseField eventDrainLatency                | Number | Time in milliseconds between the oldest event of the last dispatched batch being emitted and the batch being sent
+ * @responseField eventMaxDrainLatency             | Number | Highest `eventDrainLatency` seen since the server was started
  *
  * @requestType GetStats
  * @complexity 2
@@ -100,6 +104,51 @@ RequestResult RequestHandler::GetStats(const Request &)
 		responseData["webSocketSessionOutgoingMessages"] = nullptr;
 	}
 
+	auto webSocketServer = GetWebSocketServer();
+	if (webSocketServer) {
+		auto dispatcherStats = webSocketServer->GetEventDispatcherStats();
+		responseData["eventQueueDepth"] = dispatcherStats.queueDepth;
+		responseData["eventDrainLatency"] = dispatcherStats.lastDrainLatency / 1000000.0;
+		responseData["eventMaxDrainLatency"] = dispatcherStats.maxDrainLatency / 1000000.0;
+	}
+
+	return RequestResult::Success(responseData);
+}
+
+/**
+ * Gets how often each request type was processed since obs-websocket was started, and how long processing took.
+ *
+ * Counts are shared by all sessions. Only request types which were processed at least once are listed.
+ *
+ * Each object in `requests` contains:
+ * - `requestType` (String), `requestCount` (Number) and `failedRequestCount` (Number)
+ * - `totalDuration` and `maxDuration` (Number), in milliseconds
+ * - `durationHistogram` (Array<Number>), where entry `i` counts requests which took less than 2^i microseconds.
+ *   The last entry also counts all slower requests.
+ *
+ * @responseField requests | Array<Object> | Statistics of each request type
+ *
+ * @requestType GetRequestStats
+ * @complexity 2
+ * @rpcVersion -1
+ * @initialVersion 5.1.0
+ * @category general
+ * @api requests
+ */
+RequestResult RequestHandler::GetRequestStats(const Request &)
+{
+	json requests = json::array();
+	for (size_t i = 0; i < _requestTypeCount; i++) {
+		if (!_requestTypeStats[i].count.load(std::memory_order_relaxed))
+			continue;
+
+		json requestStats = _requestTypeStats[i].ToJson();
+		requestStats["requestType"] = std::string(_requestTypes[i].name);
+		requests.push_back(requestStats);
+	}
+
+	json responseData;
+	responseData["requests"] = requests;
 	return RequestResult::Success(responseData);
 }
 
@@ -126,7 +175,8 @@ RequestResult RequestHandler::BroadcastCustomEvent(const Request &request)
 	if (!webSocketServer)
 		return RequestResult::Error(RequestStatus::RequestProcessingFailed, "Unable to send event due to internal error.");
 
-	webSocketServer->BroadcastEvent(EventSubscription::General, "CustomEvent", request.RequestData["eventData"]);
+	webSocketServer->BroadcastEvent(
+		std::make_shared<Event>(EventSubscription::General, "CustomEvent", request.RequestData["eventData"]));
 
 	return RequestResult::Success();
 }
@@ -235,11 +285,21 @@ RequestResult RequestHandler::TriggerHotkeyByName(const Request &request)
 	if (!request.ValidateString("hotkeyName", statusCode, comment))
 		return RequestResult::Error(statusCode, comment);
 
-	obs_hotkey_t *hotkey = Utils::Obs::SearchHelper::GetHotkeyByName(request.RequestData["hotkeyName"]);
-	if (!hotkey)
-		return RequestResult::Error(RequestStatus::ResourceNotFound, "No hotkeys were found by that name.");
+	const std::string &hotkeyName = request.RequestData["hotkeyName"].get_ref<const std::string &>();
+
+	obs_hotkey_id hotkeyId;
+	auto eventHandler = GetEventHandler();
+	if (eventHandler) {
+		if (!eventHandler->GetHotkeyIdByName(hotkeyName, hotkeyId))
+			return RequestResult::Error(RequestStatus::ResourceNotFound, "No hotkeys were found by that name.");
+	} else {
+		obs_hotkey_t *hotkey = Utils::Obs::SearchHelper::GetHotkeyByName(hotkeyName);
+		if (!hotkey)
+			return RequestResult::Error(RequestStatus::ResourceNotFound, "No hotkeys were found by that name.");
+		hotkeyId = obs_hotkey_get_id(hotkey);
+	}
 
-	obs_hotkey_trigger_routed_callback(obs_hotkey_get_id(hotkey), true);
+	obs_hotkey_trigger_routed_callback(hotkeyId, true);
 
 	return RequestResult::Success();
 }
@@ -301,6 +361,12 @@ RequestResult RequestHandler::TriggerHotkeyByKeySequence(const Request &request)
 		return RequestResult::Error(RequestStatus::CannotAct,
 					    "Your provided request fields cannot be used to trigger a hotkey.");
 
+	// Nothing can fire if no binding uses the key, or is made of modifiers only. libobs does the actual matching.
+	auto eventHandler = GetEventHandler();
+	if (eventHandler && !eventHandler->IsHotkeyKeyBound(combo.key) &&
+	    !(combo.modifiers && eventHandler->IsHotkeyKeyBound(OBS_KEY_NONE)))
+		return RequestResult::Success();
+
 	// Apparently things break when you don't start by setting the combo to false
 	obs_hotkey_inject_event(combo, false);
 	obs_hotkey_inject_event(combo, true);
@@ -417,14 +417,18 @@ RequestResult RequestHandler::SetInputMute(const Request &request)
 {
 	RequestStatus::RequestStatus statusCode;
 	std::string comment;
-	OBSSourceAutoRelease input = request.ValidateInput("inputName", statusCode, comment);
-	if (!(input && request.ValidateBoolean("inputMuted", statusCode, comment)))
+	RequestArgs::SetInputMute args;
+	if (!args.Parse(request, statusCode, comment))
+		return RequestResult::Error(statusCode, comment);
+
+	OBSSourceAutoRelease input = Request::FindInput(args.inputName, statusCode, comment);
+	if (!input)
 		return RequestResult::Error(statusCode, comment);
 
 	if (!(obs_source_get_output_flags(input) & OBS_SOURCE_AUDIO))
 		return RequestResult::Error(RequestStatus::InvalidResourceState, "The specified input does not support audio.");
 
-	obs_source_set_muted(input, request.RequestData["inputMuted"]);
+	obs_source_set_muted(input, args.inputMuted);
 
 	return RequestResult::Success();
 }
@@ -447,7 +451,11 @@ RequestResult RequestHandler::ToggleInputMute(const Request &request)
 {
 	RequestStatus::RequestStatus statusCode;
 	std::string comment;
-	OBSSourceAutoRelease input = request.ValidateInput("inputName", statusCode, comment);
+	RequestArgs::ToggleInputMute args;
+	if (!args.Parse(request, statusCode, comment))
+		return RequestResult::Error(statusCode, comment);
+
+	OBSSourceAutoRelease input = Request::FindInput(args.inputName, statusCode, comment);
 	if (!input)
 		return RequestResult::Error(statusCode, comment);
 
@@ -712,32 +720,28 @@ RequestResult RequestHandler::SetInputVolume(const Request &request)
 {
 	RequestStatus::RequestStatus statusCode;
 	std::string comment;
-	OBSSourceAutoRelease input = request.ValidateInput("inputName", statusCode, comment);
+	RequestArgs::SetInputVolume args;
+	if (!args.Parse(request, statusCode, comment))
+		return RequestResult::Error(statusCode, comment);
+
+	OBSSourceAutoRelease input = Request::FindInput(args.inputName, statusCode, comment);
 	if (!input)
 		return RequestResult::Error(statusCode, comment);
 
 	if (!(obs_source_get_output_flags(input) & OBS_SOURCE_AUDIO))
 		return RequestResult::Error(RequestStatus::InvalidResourceState, "The specified input does not support audio.");
 
-	bool hasMul = request.Contains("inputVolumeMul");
-	if (hasMul && !request.ValidateOptionalNumber("inputVolumeMul", statusCode, comment, 0, 20))
-		return RequestResult::Error(statusCode, comment);
-
-	bool hasDb = request.Contains("inputVolumeDb");
-	if (hasDb && !request.ValidateOptionalNumber("inputVolumeDb", statusCode, comment, -100, 26))
-		return RequestResult::Error(statusCode, comment);
-
-	if (hasMul && hasDb)
+	if (args.inputVolumeMul && args.inputVolumeDb)
 		return RequestResult::Error(RequestStatus::TooManyRequestFields, "You may only specify one volume field.");
 
-	if (!hasMul && !hasDb)
+	if (!args.inputVolumeMul && !args.inputVolumeDb)
 		return RequestResult::Error(RequestStatus::MissingRequestField, "You must specify one volume field.");
 
 	float inputVolumeMul;
-	if (hasMul)
-		inputVolumeMul = request.RequestData["inputVolumeMul"];
+	if (args.inputVolumeMul)
+		inputVolumeMul = *args.inputVolumeMul;
 	else
-		inputVolumeMul = obs_db_to_mul(request.RequestData["inputVolumeDb"]);
+		inputVolumeMul = obs_db_to_mul(*args.inputVolumeDb);
 
 	obs_source_set_volume(input, inputVolumeMul);
 
@@ -792,15 +796,18 @@ RequestResult RequestHandler::SetInputAudioBalance(const Request &request)
 {
 	RequestStatus::RequestStatus statusCode;
 	std::string comment;
-	OBSSourceAutoRelease input = request.ValidateInput("inputName", statusCode, comment);
-	if (!(input && request.ValidateNumber("inputAudioBalance", statusCode, comment, 0.0, 1.0)))
+	RequestArgs::SetInputAudioBalance args;
+	if (!args.Parse(request, statusCode, comment))
+		return RequestResult::Error(statusCode, comment);
+
+	OBSSourceAutoRelease input = Request::FindInput(args.inputName, statusCode, comment);
+	if (!input)
 		return RequestResult::Error(statusCode, comment);
 
 	if (!(obs_source_get_output_flags(input) & OBS_SOURCE_AUDIO))
 		return RequestResult::Error(RequestStatus::InvalidResourceState, "The specified input does not support audio.");
 
-	float inputAudioBalance = request.RequestData["inputAudioBalance"];
-	obs_source_set_balance_value(input, inputAudioBalance);
+	obs_source_set_balance_value(input, (float)args.inputAudioBalance);
 
 	return RequestResult::Success();
 }
@@ -513,14 +513,16 @@ RequestResult RequestHandler::SetSceneItemEnabled(const Request &request)
 {
 	RequestStatus::RequestStatus statusCode;
 	std::string comment;
-	OBSSceneItemAutoRelease sceneItem = request.ValidateSceneItem("sceneName", "sceneItemId", statusCode, comment,
-								      OBS_WEBSOCKET_SCENE_FILTER_SCENE_OR_GROUP);
-	if (!(sceneItem && request.ValidateBoolean("sceneItemEnabled", statusCode, comment)))
+	RequestArgs::SetSceneItemEnabled args;
+	if (!args.Parse(request, statusCode, comment))
 		return RequestResult::Error(statusCode, comment);
 
-	bool sceneItemEnabled = request.RequestData["sceneItemEnabled"];
+	OBSSceneItemAutoRelease sceneItem = Request::FindSceneItem(args.sceneName, (int64_t)args.sceneItemId, statusCode, comment,
+								   OBS_WEBSOCKET_SCENE_FILTER_SCENE_OR_GROUP);
+	if (!sceneItem)
+		return RequestResult::Error(statusCode, comment);
 
-	obs_sceneitem_set_visible(sceneItem, sceneItemEnabled);
+	obs_sceneitem_set_visible(sceneItem, args.sceneItemEnabled);
 
 	return RequestResult::Success();
 }
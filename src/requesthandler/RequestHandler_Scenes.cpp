@@ -114,7 +114,11 @@ RequestResult RequestHandler::SetCurrentProgramScene(const Request &request)
 {
 	RequestStatus::RequestStatus statusCode;
 	std::string comment;
-	OBSSourceAutoRelease scene = request.ValidateScene("sceneName", statusCode, comment);
+	RequestArgs::SetCurrentProgramScene args;
+	if (!args.Parse(request, statusCode, comment))
+		return RequestResult::Error(statusCode, comment);
+
+	OBSSourceAutoRelease scene = Request::FindScene(args.sceneName, statusCode, comment);
 	if (!scene)
 		return RequestResult::Error(statusCode, comment);
 
@@ -171,7 +175,11 @@ RequestResult RequestHandler::SetCurrentPreviewScene(const Request &request)
 
 	RequestStatus::RequestStatus statusCode;
 	std::string comment;
-	OBSSourceAutoRelease scene = request.ValidateScene("sceneName", statusCode, comment);
+	RequestArgs::SetCurrentPreviewScene args;
+	if (!args.Parse(request, statusCode, comment))
+		return RequestResult::Error(statusCode, comment);
+
+	OBSSourceAutoRelease scene = Request::FindScene(args.sceneName, statusCode, comment);
 	if (!scene)
 		return RequestResult::Error(statusCode, comment);
 
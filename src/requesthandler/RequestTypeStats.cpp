@@ -0,0 +1,53 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "RequestTypeStats.h"
+
+void RequestTypeStats::Record(uint64_t duration, bool failed)
+{
+	count.fetch_add(1, std::memory_order_relaxed);
+	if (failed)
+		failures.fetch_add(1, std::memory_order_relaxed);
+	totalDuration.fetch_add(duration, std::memory_order_relaxed);
+
+	uint64_t currentMax = maxDuration.load(std::memory_order_relaxed);
+	while (duration > currentMax && !maxDuration.compare_exchange_weak(currentMax, duration, std::memory_order_relaxed))
+		;
+
+	size_t bucket = 0;
+	for (uint64_t micros = duration / 1000; micros && bucket < HistogramBucketCount - 1; micros >>= 1)
+		bucket++;
+	histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+json RequestTypeStats::ToJson() const
+{
+	json ret;
+	ret["requestCount"] = count.load(std::memory_order_relaxed);
+	ret["failedRequestCount"] = failures.load(std::memory_order_relaxed);
+	ret["totalDuration"] = totalDuration.load(std::memory_order_relaxed) / 1000000.0;
+	ret["maxDuration"] = maxDuration.load(std::memory_order_relaxed) / 1000000.0;
+
+	json durationHistogram = json::array();
+	for (auto &bucket : histogram)
+		durationHistogram.push_back(bucket.load(std::memory_order_relaxed));
+	ret["durationHistogram"] = durationHistogram;
+
+	return ret;
+}
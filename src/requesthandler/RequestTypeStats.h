@@ -0,0 +1,41 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "../utils/Json.h"
+
+// Counters of one request type, updated by whichever thread processed the request
+struct RequestTypeStats {
+	// Bucket `i` counts requests which took less than 2^i microseconds. The last bucket also counts all slower ones.
+	static constexpr size_t HistogramBucketCount = 20;
+
+	std::atomic<uint64_t> count{0};
+	std::atomic<uint64_t> failures{0};
+	std::atomic<uint64_t> totalDuration{0}; // Nanoseconds
+	std::atomic<uint64_t> maxDuration{0};   // Nanoseconds
+	std::array<std::atomic<uint64_t>, HistogramBucketCount> histogram{};
+
+	void Record(uint64_t duration, bool failed);
+	json ToJson() const;
+};
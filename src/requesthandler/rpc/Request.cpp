@@ -18,6 +18,7 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
 #include "Request.h"
+#include "../../eventhandler/EventHandler.h"
 #include "../../obs-websocket.h"
 
 json GetDefaultJsonObject(const json &requestData)
@@ -217,9 +218,105 @@ obs_source_t *Request::ValidateSource(const std::string &keyName, RequestStatus:
 	if (!ValidateString(keyName, statusCode, comment))
 		return nullptr;
 
-	std::string sourceName = RequestData[keyName];
+	return FindSource(RequestData[keyName].get_ref<const std::string &>(), statusCode, comment);
+}
+
+obs_source_t *Request::ValidateScene(const std::string &keyName, RequestStatus::RequestStatus &statusCode, std::string &comment,
+				     const ObsWebSocketSceneFilter filter) const
+{
+	if (!ValidateString(keyName, statusCode, comment))
+		return nullptr;
+
+	return FindScene(RequestData[keyName].get_ref<const std::string &>(), statusCode, comment, filter);
+}
+
+obs_scene_t *Request::ValidateScene2(const std::string &keyName, RequestStatus::RequestStatus &statusCode, std::string &comment,
+				     const ObsWebSocketSceneFilter filter) const
+{
+	if (!ValidateString(keyName, statusCode, comment))
+		return nullptr;
+
+	return FindScene2(RequestData[keyName].get_ref<const std::string &>(), statusCode, comment, filter);
+}
+
+obs_source_t *Request::ValidateInput(const std::string &keyName, RequestStatus::RequestStatus &statusCode,
+				     std::string &comment) const
+{
+	if (!ValidateString(keyName, statusCode, comment))
+		return nullptr;
+
+	return FindInput(RequestData[keyName].get_ref<const std::string &>(), statusCode, comment);
+}
+
+FilterPair Request::ValidateFilter(const std::string &sourceKeyName, const std::string &filterKeyName,
+				   RequestStatus::RequestStatus &statusCode, std::string &comment) const
+{
+	obs_source_t *source = ValidateSource(sourceKeyName, statusCode, comment);
+	if (!source)
+		return FilterPair{source, nullptr};
+
+	if (!ValidateString(filterKeyName, statusCode, comment))
+		return FilterPair{source, nullptr};
+
+	std::string filterName = RequestData[filterKeyName];
+
+	obs_source_t *filter = obs_source_get_filter_by_name(source, filterName.c_str());
+	if (!filter) {
+		statusCode = RequestStatus::ResourceNotFound;
+		comment = std::string("No filter was found in the source `") + RequestData[sourceKeyName].get<std::string>() +
+			  "` with the name `" + filterName + "`.";
+		return FilterPair{source, nullptr};
+	}
+
+	return FilterPair{source, filter};
+}
+
+obs_sceneitem_t *Request::ValidateSceneItem(const std::string &sceneKeyName, const std::string &sceneItemIdKeyName,
+					    RequestStatus::RequestStatus &statusCode, std::string &comment,
+					    const ObsWebSocketSceneFilter filter) const
+{
+	if (!ValidateString(sceneKeyName, statusCode, comment))
+		return nullptr;
+
+	std::string sceneName = RequestData[sceneKeyName];
+	OBSSceneAutoRelease scene = FindScene2(sceneName, statusCode, comment, filter);
+	if (!scene)
+		return nullptr;
+
+	if (!ValidateNumber(sceneItemIdKeyName, statusCode, comment, 0))
+		return nullptr;
+
+	int64_t sceneItemId = RequestData[sceneItemIdKeyName];
+
+	return FindSceneItem(scene, sceneName, sceneItemId, statusCode, comment);
+}
+
+obs_output_t *Request::ValidateOutput(const std::string &keyName, RequestStatus::RequestStatus &statusCode,
+				      std::string &comment) const
+{
+	if (!ValidateString(keyName, statusCode, comment))
+		return nullptr;
 
-	obs_source_t *ret = obs_get_source_by_name(sourceName.c_str());
+	std::string outputName = RequestData[keyName];
+
+	obs_output_t *ret = obs_get_output_by_name(outputName.c_str());
+	if (!ret) {
+		statusCode = RequestStatus::ResourceNotFound;
+		comment = std::string("No output was found with the name `") + outputName + "`.";
+		return nullptr;
+	}
+
+	return ret;
+}
+
+obs_source_t *Request::FindSource(const std::string &sourceName, RequestStatus::RequestStatus &statusCode, std::string &comment)
+{
+	// Registered inputs and scenes are found through the index kept by the event handler. Everything else, like
+	// transitions, still goes through libobs.
+	auto eventHandler = GetEventHandler();
+	obs_source_t *ret = eventHandler ? eventHandler->GetSourceByName(sourceName) : nullptr;
+	if (!ret)
+		ret = obs_get_source_by_name(sourceName.c_str());
 	if (!ret) {
 		statusCode = RequestStatus::ResourceNotFound;
 		comment = std::string("No source was found by the name of `") + sourceName + "`.";
@@ -229,10 +326,10 @@ obs_source_t *Request::ValidateSource(const std::string &keyName, RequestStatus:
 	return ret;
 }
 
-obs_source_t *Request::ValidateScene(const std::string &keyName, RequestStatus::RequestStatus &statusCode, std::string &comment,
-				     const ObsWebSocketSceneFilter filter) const
+obs_source_t *Request::FindScene(const std::string &sceneName, RequestStatus::RequestStatus &statusCode, std::string &comment,
+				 const ObsWebSocketSceneFilter filter)
 {
-	obs_source_t *ret = ValidateSource(keyName, statusCode, comment);
+	obs_source_t *ret = FindSource(sceneName, statusCode, comment);
 	if (!ret)
 		return nullptr;
 
@@ -259,10 +356,10 @@ obs_source_t *Request::ValidateScene(const std::string &keyName, RequestStatus::
 	return ret;
 }
 
-obs_scene_t *Request::ValidateScene2(const std::string &keyName, RequestStatus::RequestStatus &statusCode, std::string &comment,
-				     const ObsWebSocketSceneFilter filter) const
+obs_scene_t *Request::FindScene2(const std::string &sceneName, RequestStatus::RequestStatus &statusCode, std::string &comment,
+				 const ObsWebSocketSceneFilter filter)
 {
-	OBSSourceAutoRelease sceneSource = ValidateSource(keyName, statusCode, comment);
+	OBSSourceAutoRelease sceneSource = FindSource(sceneName, statusCode, comment);
 	if (!sceneSource)
 		return nullptr;
 
@@ -290,10 +387,9 @@ obs_scene_t *Request::ValidateScene2(const std::string &keyName, RequestStatus::
 	}
 }
 
-obs_source_t *Request::ValidateInput(const std::string &keyName, RequestStatus::RequestStatus &statusCode,
-				     std::string &comment) const
+obs_source_t *Request::FindInput(const std::string &inputName, RequestStatus::RequestStatus &statusCode, std::string &comment)
 {
-	obs_source_t *ret = ValidateSource(keyName, statusCode, comment);
+	obs_source_t *ret = FindSource(inputName, statusCode, comment);
 	if (!ret)
 		return nullptr;
 
@@ -307,66 +403,31 @@ obs_source_t *Request::ValidateInput(const std::string &keyName, RequestStatus::
 	return ret;
 }
 
-FilterPair Request::ValidateFilter(const std::string &sourceKeyName, const std::string &filterKeyName,
-				   RequestStatus::RequestStatus &statusCode, std::string &comment) const
-{
-	obs_source_t *source = ValidateSource(sourceKeyName, statusCode, comment);
-	if (!source)
-		return FilterPair{source, nullptr};
-
-	if (!ValidateString(filterKeyName, statusCode, comment))
-		return FilterPair{source, nullptr};
-
-	std::string filterName = RequestData[filterKeyName];
-
-	obs_source_t *filter = obs_source_get_filter_by_name(source, filterName.c_str());
-	if (!filter) {
-		statusCode = RequestStatus::ResourceNotFound;
-		comment = std::string("No filter was found in the source `") + RequestData[sourceKeyName].get<std::string>() +
-			  "` with the name `" + filterName + "`.";
-		return FilterPair{source, nullptr};
-	}
-
-	return FilterPair{source, filter};
-}
-
-obs_sceneitem_t *Request::ValidateSceneItem(const std::string &sceneKeyName, const std::string &sceneItemIdKeyName,
-					    RequestStatus::RequestStatus &statusCode, std::string &comment,
-					    const ObsWebSocketSceneFilter filter) const
+obs_sceneitem_t *Request::FindSceneItem(const std::string &sceneName, int64_t sceneItemId, RequestStatus::RequestStatus &statusCode,
+					std::string &comment, const ObsWebSocketSceneFilter filter)
 {
-	OBSSceneAutoRelease scene = ValidateScene2(sceneKeyName, statusCode, comment, filter);
+	OBSSceneAutoRelease scene = FindScene2(sceneName, statusCode, comment, filter);
 	if (!scene)
 		return nullptr;
 
-	if (!ValidateNumber(sceneItemIdKeyName, statusCode, comment, 0))
-		return nullptr;
-
-	int64_t sceneItemId = RequestData[sceneItemIdKeyName];
-
-	OBSSceneItem sceneItem = obs_scene_find_sceneitem_by_id(scene, sceneItemId);
-	if (!sceneItem) {
-		statusCode = RequestStatus::ResourceNotFound;
-		comment = std::string("No scene items were found in scene `") + RequestData[sceneKeyName].get<std::string>() +
-			  "` with the ID `" + std::to_string(sceneItemId) + "`.";
-		return nullptr;
-	}
-
-	obs_sceneitem_addref(sceneItem);
-	return sceneItem;
+	return FindSceneItem(scene, sceneName, sceneItemId, statusCode, comment);
 }
 
-obs_output_t *Request::ValidateOutput(const std::string &keyName, RequestStatus::RequestStatus &statusCode,
-				      std::string &comment) const
+obs_sceneitem_t *Request::FindSceneItem(obs_scene_t *scene, const std::string &sceneName, int64_t sceneItemId,
+					RequestStatus::RequestStatus &statusCode, std::string &comment)
 {
-	if (!ValidateString(keyName, statusCode, comment))
-		return nullptr;
-
-	std::string outputName = RequestData[keyName];
-
-	obs_output_t *ret = obs_get_output_by_name(outputName.c_str());
+	// Falls back to libobs, which scans the scene, for scenes which are not indexed by the event handler
+	auto eventHandler = GetEventHandler();
+	obs_sceneitem_t *ret = eventHandler ? eventHandler->GetSceneItemById(scene, sceneItemId) : nullptr;
+	if (!ret) {
+		ret = obs_scene_find_sceneitem_by_id(scene, sceneItemId);
+		if (ret)
+			obs_sceneitem_addref(ret);
+	}
 	if (!ret) {
 		statusCode = RequestStatus::ResourceNotFound;
-		comment = std::string("No output was found with the name `") + outputName + "`.";
+		comment = std::string("No scene items were found in scene `") + sceneName + "` with the ID `" +
+			  std::to_string(sceneItemId) + "`.";
 		return nullptr;
 	}
 
@@ -80,6 +80,22 @@ struct Request {
 	obs_output_t *ValidateOutput(const std::string &keyName, RequestStatus::RequestStatus &statusCode,
 				     std::string &comment) const;
 
+	// Lookups by names which were already validated, e.g. by a generated `RequestArgs` parser. All return values have
+	// incremented refcounts.
+	static obs_source_t *FindSource(const std::string &sourceName, RequestStatus::RequestStatus &statusCode,
+					std::string &comment);
+	static obs_source_t *FindScene(const std::string &sceneName, RequestStatus::RequestStatus &statusCode, std::string &comment,
+				       const ObsWebSocketSceneFilter filter = OBS_WEBSOCKET_SCENE_FILTER_SCENE_ONLY);
+	static obs_scene_t *FindScene2(const std::string &sceneName, RequestStatus::RequestStatus &statusCode, std::string &comment,
+				       const ObsWebSocketSceneFilter filter = OBS_WEBSOCKET_SCENE_FILTER_SCENE_ONLY);
+	static obs_source_t *FindInput(const std::string &inputName, RequestStatus::RequestStatus &statusCode,
+				       std::string &comment);
+	static obs_sceneitem_t *FindSceneItem(const std::string &sceneName, int64_t sceneItemId,
+					      RequestStatus::RequestStatus &statusCode, std::string &comment,
+					      const ObsWebSocketSceneFilter filter = OBS_WEBSOCKET_SCENE_FILTER_SCENE_ONLY);
+	static obs_sceneitem_t *FindSceneItem(obs_scene_t *scene, const std::string &sceneName, int64_t sceneItemId,
+					      RequestStatus::RequestStatus &statusCode, std::string &comment);
+
 	std::string RequestType;
 	bool HasRequestData;
 	json RequestData;
@@ -0,0 +1,134 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "RequestArgs.h"
+
+static bool CheckField(const RequestArgs::Field &field, const json &value, RequestStatus::RequestStatus &statusCode,
+		       std::string &comment)
+{
+	switch (field.type) {
+	case RequestArgs::FieldType::String:
+		if (!value.is_string()) {
+			statusCode = RequestStatus::InvalidRequestFieldType;
+			comment = std::string("The field value of `") + field.name + "` must be a string.";
+			return false;
+		}
+		if (value.get_ref<const std::string &>().empty() && !field.allowEmpty) {
+			statusCode = RequestStatus::RequestFieldEmpty;
+			comment = std::string("The field value of `") + field.name + "` must not be empty.";
+			return false;
+		}
+		return true;
+	case RequestArgs::FieldType::Number: {
+		if (!value.is_number()) {
+			statusCode = RequestStatus::InvalidRequestFieldType;
+			comment = std::string("The field value of `") + field.name + "` must be a number.";
+			return false;
+		}
+		double number = value;
+		if (number < field.minValue) {
+			statusCode = RequestStatus::RequestFieldOutOfRange;
+			comment = std::string("The field value of `") + field.name + "` is below the minimum of `" +
+				  std::to_string(field.minValue) + "`";
+			return false;
+		}
+		if (number > field.maxValue) {
+			statusCode = RequestStatus::RequestFieldOutOfRange;
+			comment = std::string("The field value of `") + field.name + "` is above the maximum of `" +
+				  std::to_string(field.maxValue) + "`";
+			return false;
+		}
+		return true;
+	}
+	case RequestArgs::FieldType::Boolean:
+		if (!value.is_boolean()) {
+			statusCode = RequestStatus::InvalidRequestFieldType;
+			comment = std::string("The field value of `") + field.name + "` must be boolean.";
+			return false;
+		}
+		return true;
+	case RequestArgs::FieldType::Object:
+		if (!value.is_object()) {
+			statusCode = RequestStatus::InvalidRequestFieldType;
+			comment = std::string("The field value of `") + field.name + "` must be an object.";
+			return false;
+		}
+		if (value.empty() && !field.allowEmpty) {
+			statusCode = RequestStatus::RequestFieldEmpty;
+			comment = std::string("The field value of `") + field.name + "` must not be empty.";
+			return false;
+		}
+		return true;
+	case RequestArgs::FieldType::Array:
+		if (!value.is_array()) {
+			statusCode = RequestStatus::InvalidRequestFieldType;
+			comment = std::string("The field value of `") + field.name + "` must be an array.";
+			return false;
+		}
+		if (value.empty() && !field.allowEmpty) {
+			statusCode = RequestStatus::RequestFieldEmpty;
+			comment = std::string("The field value of `") + field.name + "` must not be empty.";
+			return false;
+		}
+		return true;
+	default:
+		return true;
+	}
+}
+
+bool RequestArgs::CollectFields(const Request &request, const Field *fields, size_t fieldCount, const json **values,
+				RequestStatus::RequestStatus &statusCode, std::string &comment)
+{
+	for (size_t i = 0; i < fieldCount; i++)
+		values[i] = nullptr;
+
+	// Like `Request::Contains()`, null values count as absent
+	for (auto it = request.RequestData.begin(); it != request.RequestData.end(); ++it) {
+		if (it->is_null())
+			continue;
+
+		const std::string &key = it.key();
+		for (size_t i = 0; i < fieldCount; i++) {
+			if (key != fields[i].name)
+				continue;
+
+			if (!CheckField(fields[i], *it, statusCode, comment))
+				return false;
+
+			values[i] = &*it;
+			break;
+		}
+	}
+
+	for (size_t i = 0; i < fieldCount; i++) {
+		if (values[i] || fields[i].optional)
+			continue;
+
+		if (!request.HasRequestData) {
+			statusCode = RequestStatus::MissingRequestData;
+			comment = "Your request data is missing or invalid (non-object)";
+		} else {
+			statusCode = RequestStatus::MissingRequestField;
+			comment = std::string("Your request is missing the `") + fields[i].name + "` field.";
+		}
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,143 @@
+// Generated from docs/generated/protocol.json by cmake/GenerateRequestArgs.cmake. Do not edit.
+
+#pragma once
+
+namespace RequestArgs {
+	struct SetInputMute {
+		std::string inputName;
+		bool inputMuted = false;
+
+		bool Parse(const Request &request, RequestStatus::RequestStatus &statusCode, std::string &comment)
+		{
+			static const Field fields[] = {
+				{"inputName", FieldType::String, false, false, -INFINITY, INFINITY},
+				{"inputMuted", FieldType::Boolean, false, false, -INFINITY, INFINITY},
+			};
+			const json *values[2];
+			if (!CollectFields(request, fields, 2, values, statusCode, comment))
+				return false;
+
+			Decode(values[0], inputName);
+			Decode(values[1], inputMuted);
+			return true;
+		}
+	};
+
+	struct ToggleInputMute {
+		std::string inputName;
+
+		bool Parse(const Request &request, RequestStatus::RequestStatus &statusCode, std::string &comment)
+		{
+			static const Field fields[] = {
+				{"inputName", FieldType::String, false, false, -INFINITY, INFINITY},
+			};
+			const json *values[1];
+			if (!CollectFields(request, fields, 1, values, statusCode, comment))
+				return false;
+
+			Decode(values[0], inputName);
+			return true;
+		}
+	};
+
+	struct SetInputVolume {
+		std::string inputName;
+		std::optional<double> inputVolumeMul;
+		std::optional<double> inputVolumeDb;
+
+		bool Parse(const Request &request, RequestStatus::RequestStatus &statusCode, std::string &comment)
+		{
+			static const Field fields[] = {
+				{"inputName", FieldType::String, false, false, -INFINITY, INFINITY},
+				{"inputVolumeMul", FieldType::Number, true, false, 0, 20},
+				{"inputVolumeDb", FieldType::Number, true, false, -100, 26},
+			};
+			const json *values[3];
+			if (!CollectFields(request, fields, 3, values, statusCode, comment))
+				return false;
+
+			Decode(values[0], inputName);
+			Decode(values[1], inputVolumeMul);
+			Decode(values[2], inputVolumeDb);
+			return true;
+		}
+	};
+
+	struct SetInputAudioBalance {
+		std::string inputName;
+		double inputAudioBalance = 0;
+
+		bool Parse(const Request &request, RequestStatus::RequestStatus &statusCode, std::string &comment)
+		{
+			static const Field fields[] = {
+				{"inputName", FieldType::String, false, false, -INFINITY, INFINITY},
+				{"inputAudioBalance", FieldType::Number, false, false, 0.0, 1.0},
+			};
+			const json *values[2];
+			if (!CollectFields(request, fields, 2, values, statusCode, comment))
+				return false;
+
+			Decode(values[0], inputName);
+			Decode(values[1], inputAudioBalance);
+			return true;
+		}
+	};
+
+	struct SetSceneItemEnabled {
+		std::string sceneName;
+		double sceneItemId = 0;
+		bool sceneItemEnabled = false;
+
+		bool Parse(const Request &request, RequestStatus::RequestStatus &statusCode, std::string &comment)
+		{
+			static const Field fields[] = {
+				{"sceneName", FieldType::String, false, false, -INFINITY, INFINITY},
+				{"sceneItemId", FieldType::Number, false, false, 0, INFINITY},
+				{"sceneItemEnabled", FieldType::Boolean, false, false, -INFINITY, INFINITY},
+			};
+			const json *values[3];
+			if (!CollectFields(request, fields, 3, values, statusCode, comment))
+				return false;
+
+			Decode(values[0], sceneName);
+			Decode(values[1], sceneItemId);
+			Decode(values[2], sceneItemEnabled);
+			return true;
+		}
+	};
+
+	struct SetCurrentProgramScene {
+		std::string sceneName;
+
+		bool Parse(const Request &request, RequestStatus::RequestStatus &statusCode, std::string &comment)
+		{
+			static const Field fields[] = {
+				{"sceneName", FieldType::String, false, false, -INFINITY, INFINITY},
+			};
+			const json *values[1];
+			if (!CollectFields(request, fields, 1, values, statusCode, comment))
+				return false;
+
+			Decode(values[0], sceneName);
+			return true;
+		}
+	};
+
+	struct SetCurrentPreviewScene {
+		std::string sceneName;
+
+		bool Parse(const Request &request, RequestStatus::RequestStatus &statusCode, std::string &comment)
+		{
+			static const Field fields[] = {
+				{"sceneName", FieldType::String, false, false, -INFINITY, INFINITY},
+			};
+			const json *values[1];
+			if (!CollectFields(request, fields, 1, values, statusCode, comment))
+				return false;
+
+			Decode(values[0], sceneName);
+			return true;
+		}
+	};
+
+}
@@ -0,0 +1,82 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <cmath>
+#include <optional>
+
+#include "Request.h"
+
+// Decoding of request data against field tables generated from the `@requestField` annotations. The generated parsers
+// are in `RequestArgs.generated.h`, with one struct per request type holding its decoded fields.
+namespace RequestArgs {
+	enum class FieldType {
+		String,
+		Number,
+		Boolean,
+		Object,
+		Array,
+		Any,
+	};
+
+	struct Field {
+		const char *name;
+		FieldType type;
+		bool optional;
+		bool allowEmpty; // Strings, objects and arrays only
+		double minValue;
+		double maxValue;
+	};
+
+	// Walks the request data once, checking the type and range of every field in `fields`. Strings, objects and arrays
+	// must not be empty unless the field allows it.
+	// On success, `values[i]` points at the value of `fields[i]`, or is null if that field is optional and absent.
+	bool CollectFields(const Request &request, const Field *fields, size_t fieldCount, const json **values,
+			   RequestStatus::RequestStatus &statusCode, std::string &comment);
+
+	inline void Decode(const json *value, std::string &out)
+	{
+		out = value->get_ref<const std::string &>();
+	}
+
+	inline void Decode(const json *value, double &out)
+	{
+		out = value->get<double>();
+	}
+
+	inline void Decode(const json *value, bool &out)
+	{
+		out = value->get<bool>();
+	}
+
+	// Objects, arrays and values of any type are not copied, and point into the request data
+	inline void Decode(const json *value, const json *&out)
+	{
+		out = value;
+	}
+
+	template<typename T> inline void Decode(const json *value, std::optional<T> &out)
+	{
+		if (value)
+			Decode(value, out.emplace());
+	}
+}
+
+#include "RequestArgs.generated.h"
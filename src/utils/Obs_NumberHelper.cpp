@@ -37,7 +37,7 @@ uint64_t Utils::Obs::NumberHelper::GetOutputDuration(obs_output_t *output)
 
 size_t Utils::Obs::NumberHelper::GetSceneCount()
 {
-	size_t ret;
+	size_t ret = 0;
 	auto sceneEnumProc = [](void *param, obs_source_t *scene) {
 		auto ret = static_cast<size_t *>(param);
 
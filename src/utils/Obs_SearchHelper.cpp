@@ -17,6 +17,8 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
 #include "Obs.h"
+#include "../eventhandler/EventHandler.h"
+#include "../obs-websocket.h"
 #include "../plugin-macros.generated.h"
 
 obs_hotkey_t *Utils::Obs::SearchHelper::GetHotkeyByName(std::string name)
@@ -66,6 +68,20 @@ obs_sceneitem_t *Utils::Obs::SearchHelper::GetSceneItemByName(obs_scene_t *scene
 	if (name.empty())
 		return nullptr;
 
+	// Scenes registered by the event handler are looked up through its scene item index. The scan below remains for
+	// everything else, and for items whose source can not be found by name.
+	auto eventHandler = GetEventHandler();
+	if (eventHandler) {
+		OBSSourceAutoRelease source = eventHandler->GetSourceByName(name);
+		if (!source)
+			source = obs_get_source_by_name(name.c_str());
+		if (source) {
+			obs_sceneitem_t *ret = eventHandler->GetSceneItemBySource(scene, source, offset);
+			if (ret)
+				return ret;
+		}
+	}
+
 	SceneItemSearchData enumData;
 	enumData.name = name;
 	enumData.offset = offset;
@@ -0,0 +1,53 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "Threading.h"
+#include "Compat.h"
+
+Utils::Threading::SerialExecutor::SerialExecutor(QThreadPool *threadPool) : _threadPool(threadPool), _running(false) {}
+
+void Utils::Threading::SerialExecutor::Post(std::function<void()> task)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_tasks.push_back(std::move(task));
+	if (_running)
+		return;
+	_running = true;
+	lock.unlock();
+
+	// The runnable keeps the executor alive until the queue has been fully drained
+	auto self = shared_from_this();
+	_threadPool->start(Utils::Compat::CreateFunctionRunnable([self]() { self->Drain(); }));
+}
+
+void Utils::Threading::SerialExecutor::Drain()
+{
+	while (true) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		if (_tasks.empty()) {
+			_running = false;
+			return;
+		}
+		std::function<void()> task = std::move(_tasks.front());
+		_tasks.pop_front();
+		lock.unlock();
+
+		task();
+	}
+}
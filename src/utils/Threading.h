@@ -0,0 +1,107 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <QThreadPool>
+
+namespace Utils {
+	namespace Threading {
+		// Runs posted tasks one at a time, in posting order, on a shared thread pool. Tasks from different
+		// executors still run in parallel with each other. Always hold in a shared_ptr.
+		class SerialExecutor : public std::enable_shared_from_this<SerialExecutor> {
+		public:
+			SerialExecutor(QThreadPool *threadPool);
+
+			void Post(std::function<void()> task);
+
+		private:
+			void Drain();
+
+			QThreadPool *_threadPool;
+			std::mutex _mutex;
+			std::deque<std::function<void()>> _tasks;
+			bool _running;
+		};
+		typedef std::shared_ptr<SerialExecutor> SerialExecutorPtr;
+
+		// Lock-free multi-producer, single-consumer queue. Producers push onto an atomic stack, and the consumer takes
+		// the whole stack at once and reverses it, so items come out in the order they were pushed.
+		template<typename T> class MpscQueue {
+			struct Node {
+				T value;
+				Node *next;
+			};
+
+		public:
+			MpscQueue() : _head(nullptr) {}
+			~MpscQueue()
+			{
+				std::vector<T> discarded;
+				PopAll(discarded);
+			}
+			MpscQueue(const MpscQueue &) = delete;
+			MpscQueue &operator=(const MpscQueue &) = delete;
+
+			// Returns true if the queue was empty before the push, meaning the consumer may need to be woken up
+			bool Push(T value)
+			{
+				Node *node = new Node{std::move(value), _head.load(std::memory_order_relaxed)};
+				while (!_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+								    std::memory_order_relaxed))
+					;
+				return node->next == nullptr;
+			}
+
+			// Appends every queued item to `out`, oldest first. Returns the number of items taken.
+			size_t PopAll(std::vector<T> &out)
+			{
+				Node *node = _head.exchange(nullptr, std::memory_order_acquire);
+				Node *reversed = nullptr;
+				while (node) {
+					Node *next = node->next;
+					node->next = reversed;
+					reversed = node;
+					node = next;
+				}
+
+				size_t count = 0;
+				while (reversed) {
+					Node *next = reversed->next;
+					out.push_back(std::move(reversed->value));
+					delete reversed;
+					reversed = next;
+					count++;
+				}
+				return count;
+			}
+
+			bool Empty() const { return _head.load(std::memory_order_acquire) == nullptr; }
+
+		private:
+			std::atomic<Node *> _head;
+		};
+	}
+}
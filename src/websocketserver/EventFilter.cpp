@@ -0,0 +1,112 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "EventFilter.h"
+
+// Event data fields naming the resource an event is about
+static const char *ResourceFields[] = {"inputName", "oldInputName", "sceneName", "oldSceneName", "sourceName", "transitionName"};
+
+static const size_t MaxFilterEntries = 1000;
+
+bool EventFilter::Matches(const std::string &eventType, const json &eventData) const
+{
+	if (!eventTypes.empty() && eventTypes.find(eventType) == eventTypes.end())
+		return false;
+
+	if (resources.empty() || !eventData.is_object())
+		return true;
+
+	bool namesResource = false;
+	for (auto field : ResourceFields) {
+		auto it = eventData.find(field);
+		if (it == eventData.end() || !it->is_string())
+			continue;
+		if (resources.find(it->get_ref<const std::string &>()) != resources.end())
+			return true;
+		namesResource = true;
+	}
+	return !namesResource;
+}
+
+bool EventFilter::FiltersInputs(const std::string &eventType, const json &eventData) const
+{
+	if (resources.empty() || eventType != "InputVolumeMeters" || !eventData.is_object())
+		return false;
+
+	auto it = eventData.find("inputs");
+	return it != eventData.end() && it->is_array();
+}
+
+bool EventFilter::FilterInputs(const json &eventData, json &filteredEventData) const
+{
+	json inputs = json::array();
+	for (auto &input : eventData["inputs"]) {
+		auto it = input.find("inputName");
+		if (it != input.end() && it->is_string() && resources.find(it->get_ref<const std::string &>()) != resources.end())
+			inputs.push_back(input);
+	}
+	if (inputs.empty())
+		return false;
+
+	filteredEventData = json::object();
+	for (auto &[key, value] : eventData.items()) {
+		if (key != "inputs")
+			filteredEventData[key] = value;
+	}
+	filteredEventData["inputs"] = std::move(inputs);
+	return true;
+}
+
+static bool ParseStringSet(const json &data, const std::string &name, std::unordered_set<std::string> &set,
+			   std::string &errorMessage)
+{
+	if (!data.is_array()) {
+		errorMessage = "The `" + name + "` are not an array.";
+		return false;
+	}
+	if (data.size() > MaxFilterEntries) {
+		errorMessage = "The `" + name + "` have more than " + std::to_string(MaxFilterEntries) + " entries.";
+		return false;
+	}
+	for (auto &entry : data) {
+		if (!entry.is_string()) {
+			errorMessage = "The `" + name + "` contain a non-string entry.";
+			return false;
+		}
+		set.insert(entry.get<std::string>());
+	}
+	return true;
+}
+
+bool ParseEventFilter(const json &data, EventFilter &filter, std::string &errorMessage)
+{
+	if (!data.is_object()) {
+		errorMessage = "The event filter is not an object.";
+		return false;
+	}
+
+	EventFilter ret;
+	if (data.contains("eventTypes") && !ParseStringSet(data["eventTypes"], "eventTypes", ret.eventTypes, errorMessage))
+		return false;
+	if (data.contains("resources") && !ParseStringSet(data["resources"], "resources", ret.resources, errorMessage))
+		return false;
+
+	filter = std::move(ret);
+	return true;
+}
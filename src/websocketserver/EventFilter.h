@@ -0,0 +1,48 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include "../utils/Json.h"
+
+// Narrows a session's event subscriptions down to single event types and resources. Evaluated by the event dispatcher
+// before anything is serialized for the session.
+struct EventFilter {
+	std::unordered_set<std::string> eventTypes; // Empty allows every event type
+	std::unordered_set<std::string> resources;  // Names of inputs, scenes and other sources. Empty allows every resource.
+
+	bool IsEmpty() const { return eventTypes.empty() && resources.empty(); }
+
+	// Events which name no resource at all always match the resources
+	bool Matches(const std::string &eventType, const json &eventData) const;
+
+	// Whether the event lists several inputs which are filtered one by one. Only `InputVolumeMeters`, as inventories like
+	// `SceneCollectionLoaded` also have an `inputs` array, which must be sent whole.
+	bool FiltersInputs(const std::string &eventType, const json &eventData) const;
+	// Copies `eventData` with only the matching inputs. Returns false if none of them match.
+	bool FilterInputs(const json &eventData, json &filteredEventData) const;
+};
+
+typedef std::shared_ptr<const EventFilter> EventFilterPtr;
+
+bool ParseEventFilter(const json &data, EventFilter &filter, std::string &errorMessage);
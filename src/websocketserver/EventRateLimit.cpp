@@ -0,0 +1,95 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "EventRateLimit.h"
+
+std::string EventRateLimit::GetKey(const std::string &eventType, const json &eventData) const
+{
+	std::string ret = eventType;
+	if (!eventData.is_object())
+		return ret;
+
+	for (auto &field : coalesceBy) {
+		ret += '\n';
+		auto it = eventData.find(field);
+		if (it == eventData.end())
+			continue;
+		ret += it->is_string() ? it->get<std::string>() : it->dump();
+	}
+	return ret;
+}
+
+bool ParseEventRateLimits(const json &data, EventRateLimitTable &table, std::string &errorMessage)
+{
+	if (!data.is_object()) {
+		errorMessage = "The event rate limits are not an object.";
+		return false;
+	}
+
+	EventRateLimitTable ret = table;
+	for (auto &[eventType, limitData] : data.items()) {
+		if (limitData.is_null()) {
+			ret.erase(eventType);
+			continue;
+		}
+
+		if (!limitData.is_object()) {
+			errorMessage = "The rate limit of `" + eventType + "` is not an object.";
+			return false;
+		}
+
+		EventRateLimit limit;
+		if (limitData.contains("minInterval")) {
+			if (!limitData["minInterval"].is_number_unsigned() || limitData["minInterval"].get<uint64_t>() > 60000) {
+				errorMessage = "The `minInterval` of `" + eventType + "` is not a number from 0 to 60000.";
+				return false;
+			}
+			limit.minInterval = limitData["minInterval"];
+		}
+		if (limitData.contains("burst")) {
+			if (!limitData["burst"].is_number_unsigned() || limitData["burst"] < 1 || limitData["burst"] > 1000) {
+				errorMessage = "The `burst` of `" + eventType + "` is not a number from 1 to 1000.";
+				return false;
+			}
+			limit.burst = limitData["burst"];
+		}
+		if (limitData.contains("coalesceBy")) {
+			if (!limitData["coalesceBy"].is_array()) {
+				errorMessage = "The `coalesceBy` of `" + eventType + "` is not an array.";
+				return false;
+			}
+			for (auto &field : limitData["coalesceBy"]) {
+				if (!field.is_string()) {
+					errorMessage = "The `coalesceBy` of `" + eventType + "` contains a non-string field.";
+					return false;
+				}
+				limit.coalesceBy.push_back(field);
+			}
+		}
+
+		// A zero interval never holds anything back
+		if (limit.minInterval)
+			ret[eventType] = limit;
+		else
+			ret.erase(eventType);
+	}
+
+	table = std::move(ret);
+	return true;
+}
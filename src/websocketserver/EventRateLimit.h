@@ -0,0 +1,45 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../utils/Json.h"
+
+// Limits how often one event type is sent to a session. Events over the limit are held back, and only the latest one
+// for each coalescing key is sent once the limit allows it again.
+struct EventRateLimit {
+	uint32_t minInterval = 0;            // Milliseconds between two events with the same key
+	uint32_t burst = 1;                  // Events which may go out back to back before `minInterval` applies
+	std::vector<std::string> coalesceBy; // Event data fields making up the key. Empty coalesces the whole event type.
+
+	std::string GetKey(const std::string &eventType, const json &eventData) const;
+};
+
+// Event type -> limit
+typedef std::unordered_map<std::string, EventRateLimit> EventRateLimitTable;
+typedef std::shared_ptr<const EventRateLimitTable> EventRateLimitTablePtr;
+
+// Merges `data` into `table`. A `null` entry removes the limit of that event type. On error, `table` is left untouched.
+bool ParseEventRateLimits(const json &data, EventRateLimitTable &table, std::string &errorMessage);
@@ -0,0 +1,77 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "EventReplayBuffer.h"
+
+EventReplayBuffer::EventReplayBuffer() : _size(0), _maxSize(0), _evictedSequence(0), _lastSequence(0) {}
+
+void EventReplayBuffer::Reset(uint64_t maxSize, uint64_t lastSequence)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_entries.clear();
+	_size = 0;
+	_maxSize = maxSize;
+	_evictedSequence = lastSequence;
+	_lastSequence = lastSequence;
+}
+
+void EventReplayBuffer::Push(uint64_t sequence, EventPtr event, size_t size)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_lastSequence = sequence;
+	if (!event) {
+		// Nothing is retained while disabled, so nothing can be replayed either
+		if (!_maxSize)
+			_evictedSequence = sequence;
+		return;
+	}
+
+	// An event which could never fit is lost right away
+	if (size > _maxSize) {
+		_evictedSequence = sequence;
+		return;
+	}
+
+	_entries.push_back(Entry{std::move(event), size});
+	_size += size;
+	while (_size > _maxSize) {
+		_evictedSequence = _entries.front().event->Sequence();
+		_size -= _entries.front().size;
+		_entries.pop_front();
+	}
+}
+
+bool EventReplayBuffer::Covers(uint64_t lastSequence)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return lastSequence >= _evictedSequence && lastSequence <= _lastSequence;
+}
+
+bool EventReplayBuffer::GetEventsAfter(uint64_t lastSequence, std::vector<EventPtr> &events)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (lastSequence < _evictedSequence || lastSequence > _lastSequence)
+		return false;
+
+	for (auto &entry : _entries) {
+		if (entry.event->Sequence() > lastSequence)
+			events.push_back(entry.event);
+	}
+	return true;
+}
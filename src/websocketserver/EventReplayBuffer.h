@@ -0,0 +1,60 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "../eventhandler/types/Event.h"
+#include "../plugin-macros.generated.h"
+
+// Recently dispatched events, kept in memory so that a reconnecting client can be sent the events it missed. Bounded by
+// the size of their serialized Json messages. Written by the event dispatcher and read while handling `Identify`.
+class EventReplayBuffer {
+public:
+	EventReplayBuffer();
+
+	// Drops all retained events. Events up to `lastSequence` count as already evicted.
+	void Reset(uint64_t maxSize, uint64_t lastSequence);
+
+	// Records that the event with `sequence` was dispatched. `event` is null if it is not meant to be replayed, eg. high
+	// volume events.
+	void Push(uint64_t sequence, EventPtr event, size_t size);
+
+	// Whether every retained event after `lastSequence` is still available
+	bool Covers(uint64_t lastSequence);
+
+	// Returns false if events after `lastSequence` have been evicted in the meantime
+	bool GetEventsAfter(uint64_t lastSequence, std::vector<EventPtr> &events);
+
+private:
+	struct Entry {
+		EventPtr event;
+		size_t size;
+	};
+
+	std::mutex _mutex;
+	std::deque<Entry> _entries;
+	size_t _size;
+	uint64_t _maxSize;
+	uint64_t _evictedSequence; // Sequence of the newest event which is no longer retained
+	uint64_t _lastSequence;    // Sequence of the newest dispatched event
+};
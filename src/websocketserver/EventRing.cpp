@@ -0,0 +1,170 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <obs-module.h>
+
+#include "EventRing.h"
+#include "../../lib/obs-websocket-ring.h"
+
+#define MIN_RING_CAPACITY (64 * 1024)
+
+EventRing::EventRing() : _header(nullptr), _data(nullptr), _mappingSize(0), _sequence(0), _mapping(nullptr) {}
+
+EventRing::~EventRing()
+{
+	Close();
+}
+
+bool EventRing::Open(const std::string &name, uint64_t capacity)
+{
+	if (_header)
+		Close();
+
+	char objectName[256];
+	obs_websocket_ring_object_name(name.c_str(), objectName, sizeof(objectName));
+	_objectName = objectName;
+
+	capacity = std::max<uint64_t>(capacity, MIN_RING_CAPACITY) & ~(uint64_t)15;
+	_mappingSize = sizeof(struct obs_websocket_ring_header) + capacity;
+
+	void *mapping;
+#ifdef _WIN32
+	_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, (DWORD)((uint64_t)_mappingSize >> 32),
+				      (DWORD)(_mappingSize & 0xFFFFFFFF), _objectName.c_str());
+	if (!_mapping) {
+		blog(LOG_ERROR, "[EventRing::Open] Unable to create file mapping `%s`: %lu", _objectName.c_str(), GetLastError());
+		return false;
+	}
+
+	mapping = MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, _mappingSize);
+	if (!mapping) {
+		blog(LOG_ERROR, "[EventRing::Open] Unable to map `%s`: %lu", _objectName.c_str(), GetLastError());
+		CloseHandle(_mapping);
+		_mapping = nullptr;
+		return false;
+	}
+#else
+	int fd = shm_open(_objectName.c_str(), O_CREAT | O_RDWR, 0600);
+	if (fd < 0) {
+		blog(LOG_ERROR, "[EventRing::Open] Unable to open shared memory `%s`: %s", _objectName.c_str(), strerror(errno));
+		return false;
+	}
+
+	if (ftruncate(fd, _mappingSize) != 0) {
+		blog(LOG_ERROR, "[EventRing::Open] Unable to size shared memory `%s`: %s", _objectName.c_str(), strerror(errno));
+		close(fd);
+		shm_unlink(_objectName.c_str());
+		return false;
+	}
+
+	mapping = mmap(NULL, _mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		blog(LOG_ERROR, "[EventRing::Open] Unable to map shared memory `%s`: %s", _objectName.c_str(), strerror(errno));
+		shm_unlink(_objectName.c_str());
+		return false;
+	}
+#endif
+
+	_header = (struct obs_websocket_ring_header *)mapping;
+	_data = (uint8_t *)mapping + sizeof(struct obs_websocket_ring_header);
+	_sequence = 0;
+
+	// Readers ignore the ring until the magic is written, so it goes last
+	obs_websocket_ring_store64(&_header->write_pos, 0);
+	obs_websocket_ring_store64(&_header->reserve_pos, 0);
+	obs_websocket_ring_store64(&_header->sequence, 0);
+	_header->magic = 0;
+	_header->version = OBS_WEBSOCKET_RING_VERSION;
+	_header->capacity = capacity;
+	_header->futex = 0;
+	_header->waiters = 0;
+	obs_websocket_ring_fence();
+	_header->magic = OBS_WEBSOCKET_RING_MAGIC;
+
+	blog(LOG_INFO, "[EventRing::Open] Writing events to shared memory `%s` (%llu bytes)", _objectName.c_str(),
+	     (unsigned long long)capacity);
+	return true;
+}
+
+void EventRing::Close()
+{
+	if (!_header)
+		return;
+
+	// Existing readers keep their mapping, the name is only removed so that new readers do not attach to a dead ring
+#ifdef _WIN32
+	UnmapViewOfFile(_header);
+	CloseHandle(_mapping);
+	_mapping = nullptr;
+#else
+	munmap(_header, _mappingSize);
+	shm_unlink(_objectName.c_str());
+#endif
+	_header = nullptr;
+	_data = nullptr;
+}
+
+// Returns false if the payload is too large for the ring
+bool EventRing::Write(const std::string &payload)
+{
+	uint64_t capacity = _header->capacity;
+	uint64_t recordSize = OBS_WEBSOCKET_RING_ALIGN(sizeof(struct obs_websocket_ring_record) + payload.size());
+	if (recordSize > capacity / 2)
+		return false;
+
+	// Records never wrap. If this one does not fit before the end of the data area, the rest is filled with padding.
+	uint64_t writePos = _header->write_pos;
+	uint64_t offset = writePos % capacity;
+	uint64_t padding = offset + recordSize > capacity ? capacity - offset : 0;
+
+	// Claim the space first, so readers can detect records which are overwritten while they copy them
+	obs_websocket_ring_store64(&_header->reserve_pos, writePos + padding + recordSize);
+	obs_websocket_ring_fence();
+
+	struct obs_websocket_ring_record record;
+	if (padding) {
+		record.sequence = 0;
+		record.length = (uint32_t)(padding - sizeof(record));
+		record.flags = OBS_WEBSOCKET_RING_RECORD_PADDING;
+		memcpy(_data + offset, &record, sizeof(record));
+		offset = 0;
+	}
+
+	record.sequence = ++_sequence;
+	record.length = (uint32_t)payload.size();
+	record.flags = 0;
+	memcpy(_data + offset, &record, sizeof(record));
+	memcpy(_data + offset + sizeof(record), payload.data(), payload.size());
+
+	obs_websocket_ring_store64(&_header->sequence, _sequence);
+	obs_websocket_ring_store64(&_header->write_pos, writePos + padding + recordSize);
+
+	// Only pay for the syscall when somebody is actually asleep
+	obs_websocket_ring_add32(&_header->futex, 1);
+#ifdef __linux__
+	if (obs_websocket_ring_load32(&_header->waiters))
+		syscall(SYS_futex, &_header->futex, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+
+	return true;
+}
@@ -0,0 +1,50 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "../plugin-macros.generated.h"
+
+// lib/obs-websocket-ring.h pulls in windows.h, so it is kept out of this header
+struct obs_websocket_ring_header;
+
+// Writer side of the shared memory event ring. The layout and reader live in lib/obs-websocket-ring.h. Only the event
+// dispatcher thread writes, so there is no locking here.
+class EventRing {
+public:
+	EventRing();
+	~EventRing();
+
+	bool Open(const std::string &name, uint64_t capacity);
+	void Close();
+	bool IsOpen() { return _header != nullptr; }
+
+	bool Write(const std::string &payload);
+
+private:
+	struct obs_websocket_ring_header *_header;
+	uint8_t *_data;
+	size_t _mappingSize;
+	std::string _objectName;
+	uint64_t _sequence;
+	void *_mapping; // Windows file mapping handle
+};
@@ -0,0 +1,243 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "LocalConnection.h"
+
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+
+// Same limit that websocketpp applies to incoming WebSocket messages
+#define MAX_INCOMING_PAYLOAD_SIZE 32000000
+// Same as websocketpp's default close handshake timeout, in milliseconds
+#define CLOSE_TIMEOUT 5000
+
+LocalConnection::LocalConnection(asio::local::stream_protocol::socket socket)
+	: _socket(std::move(socket)),
+	  _strand(asio::make_strand(_socket.get_executor())),
+	  _closeTimer(_socket.get_executor()),
+	  _state(State::Open),
+	  _writing(false),
+	  _bufferedAmount(0),
+	  _closeCode(websocketpp::close::status::blank),
+	  _finished(false)
+{
+}
+
+LocalConnectionPtr LocalConnection::FromHdl(websocketpp::connection_hdl hdl, websocketpp::lib::error_code &errorCode)
+{
+	auto ret = std::static_pointer_cast<LocalConnection>(hdl.lock());
+	if (!ret)
+		errorCode = websocketpp::error::make_error_code(websocketpp::error::bad_connection);
+	return ret;
+}
+
+void LocalConnection::Start(MessageHandler messageHandler, CloseHandler closeHandler)
+{
+	_messageHandler = messageHandler;
+	_closeHandler = closeHandler;
+
+	auto self = shared_from_this();
+	asio::post(_strand, [self]() { self->ReadHeader(); });
+}
+
+websocketpp::lib::error_code LocalConnection::Send(MessagePtr message)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (_state != State::Open)
+		return websocketpp::error::make_error_code(websocketpp::error::invalid_state);
+
+	QueueFrame(message->get_opcode(), message, "");
+	return websocketpp::lib::error_code();
+}
+
+websocketpp::lib::error_code LocalConnection::Close(uint16_t closeCode, const std::string &closeReason)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (_state != State::Open)
+		return websocketpp::error::make_error_code(websocketpp::error::invalid_state);
+
+	_state = State::Closing;
+	_closeCode = closeCode;
+	_closeReason = closeReason;
+
+	// Same payload as a WebSocket close frame. The socket is shut down once it has been written.
+	std::string payload;
+	payload.push_back((char)(closeCode >> 8));
+	payload.push_back((char)(closeCode & 0xFF));
+	payload += closeReason;
+	QueueFrame(websocketpp::frame::opcode::close, nullptr, std::move(payload));
+
+	// A client which stops reading would never let the close frame through, so the connection is finished regardless
+	auto self = shared_from_this();
+	asio::post(_strand, [self]() {
+		self->_closeTimer.expires_after(std::chrono::milliseconds(CLOSE_TIMEOUT));
+		self->_closeTimer.async_wait(asio::bind_executor(self->_strand, [self](const asio::error_code &errorCode) {
+			if (errorCode != asio::error::operation_aborted)
+				self->Finish();
+		}));
+	});
+
+	return websocketpp::lib::error_code();
+}
+
+std::string LocalConnection::CloseReason()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	return _closeReason;
+}
+
+// Must be called with `_mutex` held
+void LocalConnection::QueueFrame(websocketpp::frame::opcode::value opCode, MessagePtr message, std::string payload)
+{
+	OutgoingFrame frame;
+	frame.message = message;
+	frame.payload = std::move(payload);
+	uint32_t size = (uint32_t)(message ? message->get_payload().size() : frame.payload.size());
+	frame.header = {(uint8_t)opCode, (uint8_t)(size >> 24), (uint8_t)(size >> 16), (uint8_t)(size >> 8), (uint8_t)size};
+
+	_sendQueue.push_back(std::move(frame));
+	_bufferedAmount += size;
+
+	if (_writing)
+		return;
+	_writing = true;
+	auto self = shared_from_this();
+	asio::post(_strand, [self]() { self->WriteNext(); });
+}
+
+void LocalConnection::ReadHeader()
+{
+	auto self = shared_from_this();
+	asio::async_read(_socket, asio::buffer(_readHeader),
+			 asio::bind_executor(_strand, [self](const asio::error_code &errorCode, size_t) {
+				 if (errorCode) {
+					 self->Finish();
+					 return;
+				 }
+
+				 auto opCode = (websocketpp::frame::opcode::value)self->_readHeader[0];
+				 uint32_t size = ((uint32_t)self->_readHeader[1] << 24) | ((uint32_t)self->_readHeader[2] << 16) |
+						 ((uint32_t)self->_readHeader[3] << 8) | (uint32_t)self->_readHeader[4];
+				 if (size > MAX_INCOMING_PAYLOAD_SIZE) {
+					 self->Close(websocketpp::close::status::message_too_big, "Message too big.");
+					 return;
+				 }
+
+				 self->_readPayload.resize(size);
+				 self->ReadPayload(opCode);
+			 }));
+}
+
+void LocalConnection::ReadPayload(websocketpp::frame::opcode::value opCode)
+{
+	auto self = shared_from_this();
+	asio::async_read(_socket, asio::buffer(_readPayload),
+			 asio::bind_executor(_strand, [self, opCode](const asio::error_code &errorCode, size_t) {
+				 if (errorCode) {
+					 self->Finish();
+					 return;
+				 }
+
+				 switch (opCode) {
+				 case websocketpp::frame::opcode::text:
+				 case websocketpp::frame::opcode::binary:
+					 self->_messageHandler(self, opCode, std::move(self->_readPayload));
+					 self->_readPayload.clear();
+					 self->ReadHeader();
+					 return;
+				 case websocketpp::frame::opcode::close: {
+					 // Client initiated close, echo its code back like a WebSocket server would
+					 uint16_t closeCode = websocketpp::close::status::no_status;
+					 if (self->_readPayload.size() >= 2)
+						 closeCode = ((uint8_t)self->_readPayload[0] << 8) | (uint8_t)self->_readPayload[1];
+					 std::string closeReason = self->_readPayload.size() > 2 ? self->_readPayload.substr(2) : "";
+					 self->Close(closeCode, closeReason);
+					 return;
+				 }
+				 default:
+					 self->Close(websocketpp::close::status::protocol_error, "Unknown opcode.");
+					 return;
+				 }
+			 }));
+}
+
+// Runs on the strand, writing queued frames one at a time
+void LocalConnection::WriteNext()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (_sendQueue.empty()) {
+		_writing = false;
+		bool closing = _state == State::Closing;
+		lock.unlock();
+		if (closing)
+			Finish();
+		return;
+	}
+
+	// Queued frames are never moved by later pushes, so the buffers stay valid without holding the lock
+	auto &frame = _sendQueue.front();
+	std::array<asio::const_buffer, 2> buffers = {
+		asio::buffer(frame.header), asio::buffer(frame.message ? frame.message->get_payload() : frame.payload)};
+	lock.unlock();
+
+	auto self = shared_from_this();
+	asio::async_write(_socket, buffers,
+			  asio::bind_executor(_strand, [self](const asio::error_code &errorCode, size_t) {
+				  std::unique_lock<std::mutex> lock(self->_mutex);
+				  const auto &frame = self->_sendQueue.front();
+				  self->_bufferedAmount -= frame.message ? frame.message->get_payload().size()
+									 : frame.payload.size();
+				  self->_sendQueue.pop_front();
+				  lock.unlock();
+
+				  if (errorCode) {
+					  self->Finish();
+					  return;
+				  }
+				  self->WriteNext();
+			  }));
+}
+
+// Runs on the strand once the connection is done, either after the close frame was written, on a socket error, or when
+// the close timed out
+void LocalConnection::Finish()
+{
+	if (_finished.exchange(true))
+		return;
+
+	_closeTimer.cancel();
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (_state == State::Open)
+		_closeCode = websocketpp::close::status::abnormal_close;
+	_state = State::Closed;
+	lock.unlock();
+
+	// Closing the socket aborts any write in flight, whose handler still pops its frame
+
+	asio::error_code errorCode;
+	_socket.shutdown(asio::local::stream_protocol::socket::shutdown_both, errorCode);
+	_socket.close(errorCode);
+
+	if (_closeHandler)
+		_closeHandler(shared_from_this());
+	_messageHandler = nullptr;
+	_closeHandler = nullptr;
+}
+
+#endif
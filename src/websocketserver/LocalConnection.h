@@ -0,0 +1,95 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <asio.hpp>
+#include <websocketpp/server.hpp>
+
+#include "rpc/WebSocketSession.h"
+#include "../plugin-macros.generated.h"
+
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+
+class LocalConnection;
+typedef std::shared_ptr<LocalConnection> LocalConnectionPtr;
+
+// A client connected over the AF_UNIX listener. There is no WebSocket handshake or framing. Each message is a five
+// byte header (u8 opcode, u32 big endian payload length) followed by the payload, with opcodes matching the WebSocket
+// ones (text, binary, close). The shared_ptr doubles as the session's connection_hdl.
+class LocalConnection : public std::enable_shared_from_this<LocalConnection> {
+public:
+	typedef std::function<void(LocalConnectionPtr, websocketpp::frame::opcode::value, std::string)> MessageHandler;
+	typedef std::function<void(LocalConnectionPtr)> CloseHandler;
+
+	LocalConnection(asio::local::stream_protocol::socket socket);
+
+	static LocalConnectionPtr FromHdl(websocketpp::connection_hdl hdl, websocketpp::lib::error_code &errorCode);
+
+	void Start(MessageHandler messageHandler, CloseHandler closeHandler);
+	websocketpp::lib::error_code Send(MessagePtr message);
+	websocketpp::lib::error_code Close(uint16_t closeCode, const std::string &closeReason);
+
+	size_t BufferedAmount() { return _bufferedAmount.load(); }
+	uint16_t CloseCode() { return _closeCode.load(); }
+	std::string CloseReason();
+
+private:
+	enum State { Open, Closing, Closed };
+
+	struct OutgoingFrame {
+		std::array<uint8_t, 5> header;
+		MessagePtr message;
+		std::string payload; // Only used when there is no message, eg. for close frames
+	};
+
+	void QueueFrame(websocketpp::frame::opcode::value opCode, MessagePtr message, std::string payload);
+	void ReadHeader();
+	void ReadPayload(websocketpp::frame::opcode::value opCode);
+	void WriteNext();
+	void Finish();
+
+	asio::local::stream_protocol::socket _socket;
+	asio::strand<asio::local::stream_protocol::socket::executor_type> _strand;
+	asio::steady_timer _closeTimer; // Only used on the strand
+	MessageHandler _messageHandler;
+	CloseHandler _closeHandler;
+
+	std::array<uint8_t, 5> _readHeader;
+	std::string _readPayload;
+
+	std::mutex _mutex;
+	State _state;
+	std::string _closeReason;
+	std::deque<OutgoingFrame> _sendQueue;
+	bool _writing;
+
+	std::atomic<size_t> _bufferedAmount;
+	std::atomic<uint16_t> _closeCode;
+	std::atomic<bool> _finished;
+};
+
+#endif
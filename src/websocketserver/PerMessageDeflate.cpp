@@ -0,0 +1,193 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <websocketpp/config/asio_no_tls.hpp>
+#include <websocketpp/processors/base.hpp>
+
+#include "PerMessageDeflate.h"
+#include "../obs-websocket.h"
+#include "../Config.h"
+
+namespace DeflateError = websocketpp::extensions::permessage_deflate::error;
+
+// websocketpp only checks its message size limit against the compressed frames, so it is applied while inflating too
+#define MAX_INFLATED_MESSAGE_SIZE websocketpp::config::asio::max_message_size
+
+thread_local bool PerMessageDeflate::_negotiated = false;
+
+PerMessageDeflate::PerMessageDeflate()
+	: _enabled(false),
+	  _initialized(false),
+	  _serverNoContextTakeover(false),
+	  _serverMaxWindowBits(15),
+	  _deflateBuffer(16384),
+	  _inflateBuffer(16384)
+{
+	// A new extension is made for every handshake, on the thread which is about to negotiate it
+	_negotiated = false;
+
+	_deflateStream.zalloc = Z_NULL;
+	_deflateStream.zfree = Z_NULL;
+	_deflateStream.opaque = Z_NULL;
+	_inflateStream.zalloc = Z_NULL;
+	_inflateStream.zfree = Z_NULL;
+	_inflateStream.opaque = Z_NULL;
+	_inflateStream.avail_in = 0;
+	_inflateStream.next_in = Z_NULL;
+}
+
+PerMessageDeflate::~PerMessageDeflate()
+{
+	if (!_initialized)
+		return;
+
+	deflateEnd(&_deflateStream);
+	inflateEnd(&_inflateStream);
+}
+
+// Only used by clients
+websocketpp::lib::error_code PerMessageDeflate::validate_offer(websocketpp::http::attribute_list const &)
+{
+	return DeflateError::make_error_code(DeflateError::general);
+}
+
+// Accepts the client's offer if compression is enabled and every parameter in it can be honoured. A declined offer
+// is not an error, the connection simply proceeds without the extension.
+std::pair<websocketpp::lib::error_code, std::string>
+PerMessageDeflate::negotiate(websocketpp::http::attribute_list const &offer)
+{
+	std::pair<websocketpp::lib::error_code, std::string> ret;
+
+	auto conf = GetConfig();
+	if (!conf || !conf->CompressionEnabled) {
+		ret.first = DeflateError::make_error_code(DeflateError::general);
+		return ret;
+	}
+
+	// Parsed into locals, so a rejected offer leaves the extension untouched
+	bool serverNoContextTakeover = false;
+	bool clientNoContextTakeover = false;
+	uint8_t serverMaxWindowBits = 15;
+	bool serverMaxWindowBitsRequested = false;
+	for (auto &[attribute, value] : offer) {
+		if (attribute == "server_no_context_takeover") {
+			serverNoContextTakeover = true;
+		} else if (attribute == "client_no_context_takeover") {
+			clientNoContextTakeover = true;
+		} else if (attribute == "server_max_window_bits") {
+			int bits = value.empty() ? 0 : std::atoi(value.c_str());
+			// zlib silently raises a raw deflate window of 8 bits to 9, which the client would not be able to decode
+			if (bits < 9 || bits > 15) {
+				ret.first = DeflateError::make_error_code(DeflateError::invalid_max_window_bits);
+				return ret;
+			}
+			serverMaxWindowBits = bits;
+			serverMaxWindowBitsRequested = true;
+		} else if (attribute == "client_max_window_bits") {
+			// Inflating with the largest window decodes anything the client may produce, so nothing to do here
+			continue;
+		} else {
+			ret.first = DeflateError::make_error_code(DeflateError::invalid_attributes);
+			return ret;
+		}
+	}
+
+	_enabled = true;
+	_negotiated = true;
+	_serverNoContextTakeover = serverNoContextTakeover;
+	_serverMaxWindowBits = serverMaxWindowBits;
+	ret.second = "permessage-deflate";
+	if (_serverNoContextTakeover)
+		ret.second += "; server_no_context_takeover";
+	if (clientNoContextTakeover)
+		ret.second += "; client_no_context_takeover";
+	if (serverMaxWindowBitsRequested)
+		ret.second += "; server_max_window_bits=" + std::to_string(_serverMaxWindowBits);
+	return ret;
+}
+
+bool PerMessageDeflate::TakeNegotiated()
+{
+	bool negotiated = _negotiated;
+	_negotiated = false;
+	return negotiated;
+}
+
+websocketpp::lib::error_code PerMessageDeflate::init(bool)
+{
+	auto conf = GetConfig();
+	int compressionLevel = conf ? std::clamp<int>(conf->CompressionLevel, 1, 9) : Z_DEFAULT_COMPRESSION;
+
+	if (deflateInit2(&_deflateStream, compressionLevel, Z_DEFLATED, -1 * _serverMaxWindowBits, 8, Z_DEFAULT_STRATEGY) !=
+	    Z_OK)
+		return DeflateError::make_error_code(DeflateError::zlib_error);
+
+	if (inflateInit2(&_inflateStream, -15) != Z_OK) {
+		deflateEnd(&_deflateStream);
+		return DeflateError::make_error_code(DeflateError::zlib_error);
+	}
+
+	_initialized = true;
+	return websocketpp::lib::error_code();
+}
+
+// Output ends with the 0x00 0x00 0xff 0xff sync flush marker, which websocketpp strips before framing
+websocketpp::lib::error_code PerMessageDeflate::compress(std::string const &in, std::string &out)
+{
+	if (!_initialized)
+		return DeflateError::make_error_code(DeflateError::uninitialized);
+
+	_deflateStream.avail_in = (uInt)in.size();
+	_deflateStream.next_in = (Bytef *)in.data();
+	do {
+		_deflateStream.avail_out = (uInt)_deflateBuffer.size();
+		_deflateStream.next_out = _deflateBuffer.data();
+		deflate(&_deflateStream, Z_SYNC_FLUSH);
+		out.append((char *)_deflateBuffer.data(), _deflateBuffer.size() - _deflateStream.avail_out);
+	} while (_deflateStream.avail_out == 0);
+
+	if (_serverNoContextTakeover)
+		deflateReset(&_deflateStream);
+
+	return websocketpp::lib::error_code();
+}
+
+websocketpp::lib::error_code PerMessageDeflate::decompress(uint8_t const *buf, size_t len, std::string &out)
+{
+	if (!_initialized)
+		return DeflateError::make_error_code(DeflateError::uninitialized);
+
+	_inflateStream.avail_in = (uInt)len;
+	_inflateStream.next_in = (Bytef *)buf;
+	do {
+		_inflateStream.avail_out = (uInt)_inflateBuffer.size();
+		_inflateStream.next_out = _inflateBuffer.data();
+		int ret = inflate(&_inflateStream, Z_SYNC_FLUSH);
+		if (ret == Z_NEED_DICT || ret == Z_DATA_ERROR || ret == Z_MEM_ERROR)
+			return DeflateError::make_error_code(DeflateError::zlib_error);
+		out.append((char *)_inflateBuffer.data(), _inflateBuffer.size() - _inflateStream.avail_out);
+		// `out` holds the whole message so far, as websocketpp inflates every frame of a message into it
+		if (out.size() > MAX_INFLATED_MESSAGE_SIZE)
+			return websocketpp::processor::error::make_error_code(websocketpp::processor::error::message_too_big);
+	} while (_inflateStream.avail_out == 0);
+
+	return websocketpp::lib::error_code();
+}
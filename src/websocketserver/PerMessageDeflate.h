@@ -0,0 +1,64 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <zlib.h>
+#include <websocketpp/extensions/permessage_deflate/enabled.hpp>
+
+#include "../plugin-macros.generated.h"
+
+// permessage-deflate (RFC 7692) extension for the server side of websocketpp. websocketpp's own implementation always
+// compresses at zlib's default level, which costs too much CPU on a machine which is also encoding video, so this one
+// takes the level (and whether to accept the extension at all) from the plugin config when a client connects.
+class PerMessageDeflate {
+public:
+	PerMessageDeflate();
+	~PerMessageDeflate();
+
+	// Interface required by websocketpp's processor
+	bool is_implemented() const { return true; }
+	bool is_enabled() const { return _enabled; }
+	std::string generate_offer() const { return ""; }
+	websocketpp::lib::error_code validate_offer(websocketpp::http::attribute_list const &);
+	std::pair<websocketpp::lib::error_code, std::string> negotiate(websocketpp::http::attribute_list const &offer);
+	websocketpp::lib::error_code init(bool isServer);
+	websocketpp::lib::error_code compress(std::string const &in, std::string &out);
+	websocketpp::lib::error_code decompress(uint8_t const *buf, size_t len, std::string &out);
+
+	// websocketpp keeps the extension out of reach of the connection, so whether the handshake which just ran on this
+	// thread accepted the extension is handed over through here. Only valid from the validate handler, which runs on
+	// the same thread right after negotiation. Resets the state, so it can only be taken once.
+	static bool TakeNegotiated();
+
+private:
+	static thread_local bool _negotiated;
+
+	bool _enabled;
+	bool _initialized;
+	bool _serverNoContextTakeover;
+	uint8_t _serverMaxWindowBits;
+	z_stream _deflateStream;
+	z_stream _inflateStream;
+	// One per direction, as compress() and decompress() may run at the same time on different threads
+	std::vector<unsigned char> _deflateBuffer;
+	std::vector<unsigned char> _inflateBuffer;
+};
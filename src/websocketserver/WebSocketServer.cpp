@@ -17,6 +17,7 @@ You should have received a copy of the GNU General Public License along
 with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <QDateTime>
@@ -29,9 +30,24 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include "../Config.h"
 #include "../utils/Crypto.h"
 #include "../utils/Platform.h"
-#include "../utils/Compat.h"
-
-WebSocketServer::WebSocketServer() : QObject(nullptr), _sessions()
+#include "../utils/Threading.h"
+
+WebSocketServer::WebSocketServer()
+	: QObject(nullptr),
+	  _sessions(),
+	  _subscribers(std::make_shared<SubscriberTable>()),
+	  _globalEventRateLimits(std::make_shared<EventRateLimitTable>()),
+	  _eventRingSubscriptions(0),
+	  _eventReplayEnabled(false),
+	  _eventSequence(0),
+	  _eventReplayRequested(false),
+	  _udpSocketIsV6(false),
+	  _udpMaxDatagramSize(0),
+	  _eventDispatcherRunning(false),
+	  _eventQueueDepth(0),
+	  _dispatchedEvents(0),
+	  _lastEventDrainLatency(0),
+	  _maxEventDrainLatency(0)
 {
 	_server.get_alog().clear_channels(websocketpp::log::alevel::all);
 	_server.get_elog().clear_channels(websocketpp::log::elevel::all);
@@ -45,12 +61,10 @@ WebSocketServer::WebSocketServer() : QObject(nullptr), _sessions()
 		websocketpp::lib::bind(&WebSocketServer::onValidate, this, websocketpp::lib::placeholders::_1));
 	_server.set_open_handler(websocketpp::lib::bind(&WebSocketServer::onOpen, this, websocketpp::lib::placeholders::_1));
 	_server.set_close_handler(websocketpp::lib::bind(&WebSocketServer::onClose, this, websocketpp::lib::placeholders::_1));
-	_server.set_message_handler(websocketpp::lib::bind(&WebSocketServer::onMessage, this, websocketpp::lib::placeholders::_1,
-							   websocketpp::lib::placeholders::_2));
+	// Message handlers are set per-connection in `onOpen()` so that they can hold their session directly
 
 	auto eventHandler = GetEventHandler();
-	eventHandler->SetBroadcastCallback(std::bind(&WebSocketServer::BroadcastEvent, this, std::placeholders::_1,
-						     std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
+	eventHandler->SetBroadcastCallback(std::bind(&WebSocketServer::BroadcastEvent, this, std::placeholders::_1));
 
 	eventHandler->SetObsLoadedCallback(std::bind(&WebSocketServer::onObsLoaded, this));
 }
@@ -123,10 +137,23 @@ void WebSocketServer::Start()
 
 	_server.start_accept();
 
-	_serverThread = std::thread(&WebSocketServer::ServerRunner, this);
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+	StartLocalListener();
+#endif
+
+	StartEventDispatcher();
 
-	blog(LOG_INFO, "[WebSocketServer::Start] Server started successfully on port %d. Possible connect address: %s",
-	     conf->ServerPort.load(), Utils::Platform::GetLocalAddress().c_str());
+	// Every IO thread runs the same io_context. websocketpp wraps each connection's handlers in its own strand
+	// (config::asio enables multithreading), so a single connection is never serviced by two threads at once.
+	size_t ioThreadCount = conf->ServerIoThreads;
+	if (!ioThreadCount)
+		ioThreadCount = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+	for (size_t i = 0; i < ioThreadCount; i++)
+		_serverThreads.emplace_back(&WebSocketServer::ServerRunner, this);
+
+	blog(LOG_INFO,
+	     "[WebSocketServer::Start] Server started successfully on port %d with %zu IO thread(s). Possible connect address: %s",
+	     conf->ServerPort.load(), ioThreadCount, Utils::Platform::GetLocalAddress().c_str());
 }
 
 void WebSocketServer::Stop()
@@ -138,16 +165,22 @@ void WebSocketServer::Stop()
 
 	_server.stop_listening();
 
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+	StopLocalListener();
+#endif
+
 	std::unique_lock<std::mutex> lock(_sessionMutex);
 	for (auto const &[hdl, session] : _sessions) {
 		websocketpp::lib::error_code errorCode;
-		_server.pause_reading(hdl, errorCode);
-		if (errorCode) {
-			blog(LOG_INFO, "[WebSocketServer::Stop] Error: %s", errorCode.message().c_str());
-			continue;
+		if (!session->IsLocal()) {
+			_server.pause_reading(hdl, errorCode);
+			if (errorCode) {
+				blog(LOG_INFO, "[WebSocketServer::Stop] Error: %s", errorCode.message().c_str());
+				continue;
+			}
 		}
 
-		_server.close(hdl, websocketpp::close::status::going_away, "Server stopping.", errorCode);
+		errorCode = CloseSession(session, hdl, websocketpp::close::status::going_away, "Server stopping.");
 		if (errorCode) {
 			blog(LOG_INFO, "[WebSocketServer::Stop] Error: %s", errorCode.message().c_str());
 			continue;
@@ -155,14 +188,21 @@ void WebSocketServer::Stop()
 	}
 	lock.unlock();
 
-	_threadPool.waitForDone();
-
 	// This can delay the thread that it is running on. Bad but kinda required.
 	while (_sessions.size() > 0) {
 		std::this_thread::sleep_for(std::chrono::milliseconds(10));
 	}
 
-	_serverThread.join();
+	// Closing sessions queue their final cleanup onto the thread pool, so wait for it after they are all gone
+	_threadPool.waitForDone();
+
+	ClearSuspendedSessions();
+
+	StopEventDispatcher();
+
+	for (auto &serverThread : _serverThreads)
+		serverThread.join();
+	_serverThreads.clear();
 
 	blog(LOG_INFO, "[WebSocketServer::Stop] Server stopped successfully");
 }
@@ -171,14 +211,23 @@ void WebSocketServer::InvalidateSession(websocketpp::connection_hdl hdl)
 {
 	blog(LOG_INFO, "[WebSocketServer::InvalidateSession] Invalidating a session.");
 
-	websocketpp::lib::error_code errorCode;
-	_server.pause_reading(hdl, errorCode);
-	if (errorCode) {
-		blog(LOG_INFO, "[WebSocketServer::InvalidateSession] Error: %s", errorCode.message().c_str());
+	std::unique_lock<std::mutex> lock(_sessionMutex);
+	auto it = _sessions.find(hdl);
+	if (it == _sessions.end())
 		return;
+	SessionPtr session = it->second;
+	lock.unlock();
+
+	websocketpp::lib::error_code errorCode;
+	if (!session->IsLocal()) {
+		_server.pause_reading(hdl, errorCode);
+		if (errorCode) {
+			blog(LOG_INFO, "[WebSocketServer::InvalidateSession] Error: %s", errorCode.message().c_str());
+			return;
+		}
 	}
 
-	_server.close(hdl, WebSocketCloseCode::SessionInvalidated, "Your session has been invalidated.", errorCode);
+	errorCode = CloseSession(session, hdl, WebSocketCloseCode::SessionInvalidated, "Your session has been invalidated.");
 	if (errorCode) {
 		blog(LOG_INFO, "[WebSocketServer::InvalidateSession] Error: %s", errorCode.message().c_str());
 		return;
@@ -196,15 +245,171 @@ std::vector<WebSocketServer::WebSocketSessionState> WebSocketServer::GetWebSocke
 		uint64_t outgoingMessages = session->OutgoingMessages();
 		std::string remoteAddress = session->RemoteAddress();
 		bool isIdentified = session->IsIdentified();
+		uint64_t droppedMessages = session->DroppedMessages();
+
+		size_t outboundQueueBytes = 0;
+		GetBufferedAmount(session, hdl, outboundQueueBytes);
 
-		webSocketSessions.emplace_back(
-			WebSocketSessionState{hdl, remoteAddress, connectedAt, incomingMessages, outgoingMessages, isIdentified});
+		webSocketSessions.emplace_back(WebSocketSessionState{hdl, remoteAddress, connectedAt, incomingMessages,
+								     outgoingMessages, isIdentified, outboundQueueBytes,
+								     droppedMessages});
 	}
 	lock.unlock();
 
 	return webSocketSessions;
 }
 
+// Sessions are either WebSocket connections or local socket connections. These helpers hide which one a session uses.
+websocketpp::lib::error_code WebSocketServer::SendToConnection(SessionPtr session, websocketpp::connection_hdl hdl,
+							       MessagePtr message)
+{
+	websocketpp::lib::error_code errorCode;
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+	if (session->IsLocal()) {
+		auto connection = LocalConnection::FromHdl(hdl, errorCode);
+		return connection ? connection->Send(message) : errorCode;
+	}
+#endif
+	_server.send(hdl, message, errorCode);
+	return errorCode;
+}
+
+websocketpp::lib::error_code WebSocketServer::CloseSession(SessionPtr session, websocketpp::connection_hdl hdl,
+							   uint16_t closeCode, const std::string &closeReason)
+{
+	websocketpp::lib::error_code errorCode;
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+	if (session->IsLocal()) {
+		auto connection = LocalConnection::FromHdl(hdl, errorCode);
+		return connection ? connection->Close(closeCode, closeReason) : errorCode;
+	}
+#endif
+	_server.close(hdl, closeCode, closeReason, errorCode);
+	return errorCode;
+}
+
+websocketpp::lib::error_code WebSocketServer::GetBufferedAmount(SessionPtr session, websocketpp::connection_hdl hdl,
+								size_t &bufferedAmount)
+{
+	websocketpp::lib::error_code errorCode;
+	bufferedAmount = 0;
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+	if (session->IsLocal()) {
+		auto connection = LocalConnection::FromHdl(hdl, errorCode);
+		if (connection)
+			bufferedAmount = connection->BufferedAmount();
+		return errorCode;
+	}
+#endif
+	auto conn = _server.get_con_from_hdl(hdl, errorCode);
+	if (!errorCode)
+		bufferedAmount = conn->get_buffered_amount();
+	return errorCode;
+}
+
+// Serializes straight into the payload of a pre-framed message. Server frames are never masked, so the same message
+// can be queued on every connection without websocketpp copying the payload again.
+MessagePtr WebSocketServer::SerializeMessage(const json &message, uint8_t encoding)
+{
+	typedef WebSocketServerConfig::message_type MessageType;
+
+	std::string payload;
+	websocketpp::frame::opcode::value opcode;
+	if (encoding == WebSocketEncoding::MsgPack) {
+		json::to_msgpack(message, payload);
+		opcode = websocketpp::frame::opcode::binary;
+	} else {
+		payload = message.dump();
+		opcode = websocketpp::frame::opcode::text;
+	}
+
+	websocketpp::frame::basic_header header(opcode, payload.size(), true, false);
+	websocketpp::frame::extended_header extendedHeader(payload.size());
+
+	auto ret = std::make_shared<MessageType>(MessageType::con_msg_man_ptr(), opcode, 0);
+	ret->set_header(websocketpp::frame::prepare_header(header, extendedHeader));
+	ret->get_raw_payload() = std::move(payload);
+	ret->set_prepared(true);
+	return ret;
+}
+
+// All outgoing messages go through here so that a client which stops reading can not grow websocketpp's send buffer
+// without bound. Low priority messages are dropped or coalesced above the high-water mark according to the configured
+// policy. Normal priority messages are always queued, unless the client is so far behind that it gets disconnected.
+websocketpp::lib::error_code WebSocketServer::SendMessage(SessionPtr session, websocketpp::connection_hdl hdl,
+							  MessagePtr message, bool lowPriority, const std::string &coalesceKey)
+{
+	size_t bufferedAmount;
+	websocketpp::lib::error_code errorCode = GetBufferedAmount(session, hdl, bufferedAmount);
+	if (errorCode)
+		return errorCode;
+
+	auto conf = GetConfig();
+	uint64_t highWaterMark = conf ? conf->OutboundQueueHighWaterMark.load() : 0;
+	if (highWaterMark) {
+		uint8_t policy = conf->SlowConsumerPolicy;
+		// Only the bytes already queued count towards closing, so one large response to an idle client is still sent
+		if ((policy == SlowConsumerPolicy::Close && bufferedAmount > highWaterMark) || bufferedAmount > highWaterMark * 2) {
+			// Fails once the connection is already closing, so this is only logged once
+			errorCode = CloseSession(session, hdl, WebSocketCloseCode::SlowConsumer,
+						 "Your outbound message queue exceeded the server's limit.");
+			if (!errorCode)
+				blog(LOG_WARNING,
+				     "[WebSocketServer::SendMessage] Closing client `%s` because its outbound queue reached %zu bytes.",
+				     session->RemoteAddress().c_str(), bufferedAmount);
+			return errorCode;
+		}
+
+		// Config::Load only lets through valid policies, but anything unknown still gets the default of coalescing
+		if (lowPriority && bufferedAmount + message->get_payload().size() > highWaterMark) {
+			if (policy == SlowConsumerPolicy::Drop)
+				session->IncrementDroppedMessages();
+			else
+				session->SetPendingMessage(coalesceKey, message);
+			return errorCode;
+		}
+	}
+
+	// Compression needs per-connection deflate state, so large messages are handed to websocketpp unprepared and it
+	// frames a compressed copy for this connection. Small and high-volume messages skip compression entirely.
+	uint32_t compressionMinSize = conf ? conf->CompressionMinSize.load() : 0;
+	if (session->Compression() && !lowPriority && message->get_payload().size() >= compressionMinSize) {
+		typedef WebSocketServerConfig::message_type MessageType;
+		auto compressedMessage = std::make_shared<MessageType>(MessageType::con_msg_man_ptr(), message->get_opcode(), 0);
+		compressedMessage->set_payload(message->get_payload());
+		compressedMessage->set_compressed(true);
+		message = compressedMessage;
+	}
+
+	errorCode = SendToConnection(session, hdl, message);
+	if (!errorCode)
+		session->IncrementOutgoingMessages();
+	return errorCode;
+}
+
+// Sends the latest coalesced messages once the client's outbound queue has drained below the high-water mark.
+// Returns true if messages are still pending afterwards. Only called by the event dispatcher, which keeps the coalesced
+// messages in order with the events sent after them.
+bool WebSocketServer::FlushPendingMessages(SessionPtr session, websocketpp::connection_hdl hdl)
+{
+	size_t bufferedAmount;
+	websocketpp::lib::error_code errorCode = GetBufferedAmount(session, hdl, bufferedAmount);
+	if (errorCode)
+		return false;
+
+	auto conf = GetConfig();
+	uint64_t highWaterMark = conf ? conf->OutboundQueueHighWaterMark.load() : 0;
+	if (highWaterMark && bufferedAmount > highWaterMark)
+		return true;
+
+	for (auto &message : session->TakePendingMessages()) {
+		errorCode = SendToConnection(session, hdl, message);
+		if (!errorCode)
+			session->IncrementOutgoingMessages();
+	}
+	return false;
+}
+
 void WebSocketServer::onObsLoaded()
 {
 	auto conf = GetConfig();
@@ -223,6 +428,9 @@ bool WebSocketServer::onValidate(websocketpp::connection_hdl hdl)
 {
 	auto conn = _server.get_con_from_hdl(hdl);
 
+	// Extensions are negotiated right before this, on the same thread
+	conn->compression = PerMessageDeflate::TakeNegotiated();
+
 	std::vector<std::string> requestedSubprotocols = conn->get_requested_subprotocols();
 	for (auto subprotocol : requestedSubprotocols) {
 		if (subprotocol == "obswebsocket.json" || subprotocol == "obswebsocket.msgpack") {
@@ -238,29 +446,48 @@ void WebSocketServer::onOpen(websocketpp::connection_hdl hdl)
 {
 	auto conn = _server.get_con_from_hdl(hdl);
 
+	// Configure WebSocket specific session details
+	SessionPtr session = std::make_shared<WebSocketSession>();
+	session->SetRemoteAddress(conn->get_remote_endpoint());
+	asio::error_code errorCode;
+	auto remoteEndpoint = conn->get_raw_socket().remote_endpoint(errorCode);
+	if (!errorCode)
+		session->SetRemoteIp(remoteEndpoint.address());
+	std::string selectedSubprotocol = conn->get_subprotocol();
+	if (!selectedSubprotocol.empty()) {
+		if (selectedSubprotocol == "obswebsocket.json")
+			session->SetEncoding(WebSocketEncoding::Json);
+		else if (selectedSubprotocol == "obswebsocket.msgpack")
+			session->SetEncoding(WebSocketEncoding::MsgPack);
+	}
+	session->SetCompression(conn->compression);
+
+	AddSession(session, hdl);
+
+	// Bind the session to this connection's message handler, skipping the session map lookup on every message
+	conn->set_message_handler(websocketpp::lib::bind(&WebSocketServer::onMessage, this, session,
+							 websocketpp::lib::placeholders::_1,
+							 websocketpp::lib::placeholders::_2));
+}
+
+// Registers a new session from either listener and sends it `Hello`
+void WebSocketServer::AddSession(SessionPtr session, websocketpp::connection_hdl hdl)
+{
 	auto conf = GetConfig();
 	if (!conf) {
-		blog(LOG_ERROR, "[WebSocketServer::onOpen] Unable to retreive config!");
+		blog(LOG_ERROR, "[WebSocketServer::AddSession] Unable to retreive config!");
 		return;
 	}
 
-	// Build new session
 	std::unique_lock<std::mutex> lock(_sessionMutex);
-	SessionPtr session = _sessions[hdl] = std::make_shared<WebSocketSession>();
+	_sessions[hdl] = session;
 	std::unique_lock<std::mutex> sessionLock(session->OperationMutex);
 	lock.unlock();
 
 	// Configure session details
-	session->SetRemoteAddress(conn->get_remote_endpoint());
+	session->SetExecutor(std::make_shared<Utils::Threading::SerialExecutor>(&_threadPool));
 	session->SetConnectedAt(QDateTime::currentSecsSinceEpoch());
 	session->SetAuthenticationRequired(conf->AuthRequired);
-	std::string selectedSubprotocol = conn->get_subprotocol();
-	if (!selectedSubprotocol.empty()) {
-		if (selectedSubprotocol == "obswebsocket.json")
-			session->SetEncoding(WebSocketEncoding::Json);
-		else if (selectedSubprotocol == "obswebsocket.msgpack")
-			session->SetEncoding(WebSocketEncoding::MsgPack);
-	}
 
 	// Build `Hello`
 	json helloMessageData;
@@ -287,50 +514,54 @@ void WebSocketServer::onOpen(websocketpp::connection_hdl hdl)
 	state.incomingMessages = session->IncomingMessages();
 	state.outgoingMessages = session->OutgoingMessages();
 	state.isIdentified = session->IsIdentified();
+	state.outboundQueueBytes = 0;
+	state.droppedMessages = 0;
 
 	// Emit signals
 	emit ClientConnected(state);
 
 	// Log connection
-	blog(LOG_INFO, "[WebSocketServer::onOpen] New WebSocket client has connected from %s", session->RemoteAddress().c_str());
+	blog(LOG_INFO, "[WebSocketServer::AddSession] New WebSocket client has connected from %s",
+	     session->RemoteAddress().c_str());
 
-	blog_debug("[WebSocketServer::onOpen] Sending Op 0 (Hello) message:\n%s", helloMessage.dump(2).c_str());
+	blog_debug("[WebSocketServer::AddSession] Sending Op 0 (Hello) message:\n%s", helloMessage.dump(2).c_str());
 
 	// Send object to client
-	websocketpp::lib::error_code errorCode;
-	auto sessionEncoding = session->Encoding();
-	if (sessionEncoding == WebSocketEncoding::Json) {
-		std::string helloMessageJson = helloMessage.dump();
-		_server.send(hdl, helloMessageJson, websocketpp::frame::opcode::text, errorCode);
-	} else if (sessionEncoding == WebSocketEncoding::MsgPack) {
-		auto msgPackData = json::to_msgpack(helloMessage);
-		std::string messageMsgPack(msgPackData.begin(), msgPackData.end());
-		_server.send(hdl, messageMsgPack, websocketpp::frame::opcode::binary, errorCode);
-	}
-	session->IncrementOutgoingMessages();
+	SendMessage(session, hdl, SerializeMessage(helloMessage, session->Encoding()));
 }
 
 void WebSocketServer::onClose(websocketpp::connection_hdl hdl)
 {
 	auto conn = _server.get_con_from_hdl(hdl);
+	RemoveSession(hdl, conn->get_local_close_code(), conn->get_local_close_reason());
+}
 
+void WebSocketServer::RemoveSession(websocketpp::connection_hdl hdl, uint16_t closeCode, const std::string &closeReason)
+{
 	// Get info from the session and then delete it
 	std::unique_lock<std::mutex> lock(_sessionMutex);
 	SessionPtr session = _sessions[hdl];
-	uint64_t eventSubscriptions = session->EventSubscriptions();
 	bool isIdentified = session->IsIdentified();
 	uint64_t connectedAt = session->ConnectedAt();
 	uint64_t incomingMessages = session->IncomingMessages();
 	uint64_t outgoingMessages = session->OutgoingMessages();
+	uint64_t droppedMessages = session->DroppedMessages();
 	std::string remoteAddress = session->RemoteAddress();
 	_sessions.erase(hdl);
 	lock.unlock();
 
-	// If client was identified, decrement appropriate refs in eventhandler.
-	if (isIdentified) {
-		auto eventHandler = GetEventHandler();
-		eventHandler->ProcessUnsubscription(eventSubscriptions);
-	}
+	if (isIdentified)
+		PublishSubscriberTable();
+
+	// If client was identified, decrement appropriate refs in eventhandler, unless they are kept for a resume. This runs
+	// on the session's executor so that it happens after any message (like an `Identify`) which was still queued when
+	// the connection closed.
+	session->Executor()->Post([this, session, closeCode]() {
+		if (session->IsIdentified() && !SuspendSession(session, closeCode)) {
+			auto eventHandler = GetEventHandler();
+			eventHandler->ProcessUnsubscription(session->EventSubscriptions());
+		}
+	});
 
 	// Build SessionState object for signal
 	WebSocketSessionState state;
@@ -339,23 +570,25 @@ void WebSocketServer::onClose(websocketpp::connection_hdl hdl)
 	state.incomingMessages = incomingMessages;
 	state.outgoingMessages = outgoingMessages;
 	state.isIdentified = isIdentified;
+	state.outboundQueueBytes = 0;
+	state.droppedMessages = droppedMessages;
 
 	// Emit signals
-	emit ClientDisconnected(state, conn->get_local_close_code());
+	emit ClientDisconnected(state, closeCode);
 
 	// Log disconnection
-	blog(LOG_INFO, "[WebSocketServer::onClose] WebSocket client `%s` has disconnected with code `%d` and reason: %s",
-	     remoteAddress.c_str(), conn->get_local_close_code(), conn->get_local_close_reason().c_str());
+	blog(LOG_INFO, "[WebSocketServer::RemoveSession] WebSocket client `%s` has disconnected with code `%d` and reason: %s",
+	     remoteAddress.c_str(), closeCode, closeReason.c_str());
 
 	// Get config for tray notification
 	auto conf = GetConfig();
 	if (!conf) {
-		blog(LOG_ERROR, "[WebSocketServer::onClose] Unable to retreive config!");
+		blog(LOG_ERROR, "[WebSocketServer::RemoveSession] Unable to retreive config!");
 		return;
 	}
 
 	// If previously identified, not going away, and notifications enabled, send a tray notification
-	if (isIdentified && (conn->get_local_close_code() != websocketpp::close::status::going_away) && conf->AlertsEnabled) {
+	if (isIdentified && (closeCode != websocketpp::close::status::going_away) && conf->AlertsEnabled) {
 		QString title = obs_module_text("OBSWebSocket.TrayNotification.Disconnected.Title");
 		QString body = QString(obs_module_text("OBSWebSocket.TrayNotification.Disconnected.Body"))
 				       .arg(QString::fromStdString(remoteAddress));
@@ -363,62 +596,145 @@ void WebSocketServer::onClose(websocketpp::connection_hdl hdl)
 	}
 }
 
-void WebSocketServer::onMessage(websocketpp::connection_hdl hdl,
-				websocketpp::server<websocketpp::config::asio>::message_ptr message)
+// Keeps a disconnected session's state until its resume token is presented or the grace period runs out. Returns false
+// if the session can't be resumed, in which case the caller releases its subscription refs.
+bool WebSocketServer::SuspendSession(SessionPtr session, uint16_t closeCode)
 {
-	auto opCode = message->get_opcode();
-	std::string payload = message->get_payload();
-	_threadPool.start(Utils::Compat::CreateFunctionRunnable([=]() {
-		std::unique_lock<std::mutex> lock(_sessionMutex);
-		SessionPtr session;
-		try {
-			session = _sessions.at(hdl);
-		} catch (const std::out_of_range &oor) {
-			UNUSED_PARAMETER(oor);
-			return;
-		}
-		lock.unlock();
+	// Only sessions which the client closed or which dropped can be resumed. A resume skips authentication, so a session
+	// that the server closed (invalidated, slow, or in error) must not come back with its token.
+	switch (closeCode) {
+	case websocketpp::close::status::normal:
+	case websocketpp::close::status::going_away:
+	case websocketpp::close::status::no_status:
+	case websocketpp::close::status::abnormal_close:
+		break;
+	default:
+		return false;
+	}
+
+	auto conf = GetConfig();
+	std::string resumeToken = session->ResumeToken();
+	if (!conf || !conf->SessionResumeGracePeriod || resumeToken.empty() || !_server.is_listening())
+		return false;
+
+	SuspendedSession state;
+	state.eventSubscriptions = session->EventSubscriptions();
+	state.rpcVersion = session->RpcVersion();
+	state.udpPort = session->UdpPort();
+	state.rateLimitOverrides = session->RateLimitOverrides();
+	state.filter = session->Filter();
+	state.eventTimestamps = session->EventTimestamps();
+	state.expiry = std::make_unique<asio::steady_timer>(_server.get_io_service());
+	state.expiry->expires_after(std::chrono::milliseconds(conf->SessionResumeGracePeriod));
+	state.expiry->async_wait([this, resumeToken](const asio::error_code &errorCode) {
+		if (errorCode != asio::error::operation_aborted)
+			ExpireSuspendedSession(resumeToken);
+	});
+
+	std::unique_lock<std::mutex> lock(_suspendedSessionsMutex);
+	_suspendedSessions[resumeToken] = std::move(state);
+	return true;
+}
+
+// Takes the state of a suspended session. Its subscription refs now belong to the caller.
+bool WebSocketServer::ResumeSession(const std::string &resumeToken, SuspendedSession &state)
+{
+	std::unique_lock<std::mutex> lock(_suspendedSessionsMutex);
+	auto it = _suspendedSessions.find(resumeToken);
+	if (it == _suspendedSessions.end())
+		return false;
+
+	state = std::move(it->second);
+	_suspendedSessions.erase(it);
+	lock.unlock();
 
+	// A handler which is already queued finds nothing to expire
+	state.expiry->cancel();
+	return true;
+}
+
+void WebSocketServer::ExpireSuspendedSession(const std::string &resumeToken)
+{
+	std::unique_lock<std::mutex> lock(_suspendedSessionsMutex);
+	auto it = _suspendedSessions.find(resumeToken);
+	if (it == _suspendedSessions.end())
+		return;
+
+	uint64_t eventSubscriptions = it->second.eventSubscriptions;
+	_suspendedSessions.erase(it);
+	lock.unlock();
+
+	GetEventHandler()->ProcessUnsubscription(eventSubscriptions);
+}
+
+// Pending timers would keep the server threads running, so they are cancelled when the server stops. Also called when the
+// authentication settings change, as a resume skips authentication.
+void WebSocketServer::ClearSuspendedSessions()
+{
+	std::unique_lock<std::mutex> lock(_suspendedSessionsMutex);
+	auto suspendedSessions = std::move(_suspendedSessions);
+	_suspendedSessions.clear();
+	lock.unlock();
+
+	auto eventHandler = GetEventHandler();
+	for (auto &[resumeToken, state] : suspendedSessions) {
+		state.expiry->cancel();
+		eventHandler->ProcessUnsubscription(state.eventSubscriptions);
+	}
+}
+
+void WebSocketServer::onMessage(SessionPtr session, websocketpp::connection_hdl hdl,
+				websocketpp::server<WebSocketServerConfig>::message_ptr message)
+{
+	HandleMessage(session, hdl, message->get_opcode(), std::move(message->get_raw_payload()));
+}
+
+// Messages are executed on the session's serial executor, so each client's messages are processed in the order they
+// were received while different clients are still processed in parallel.
+void WebSocketServer::HandleMessage(SessionPtr session, websocketpp::connection_hdl hdl,
+				    websocketpp::frame::opcode::value opCode, std::string payload)
+{
+	// Stamped before queueing on the executor, so that `ClockSync` sees when the message came off the socket
+	uint64_t receivedAt = os_gettime_ns();
+
+	session->Executor()->Post([this, session, hdl, opCode, receivedAt, payload = std::move(payload)]() {
 		session->IncrementIncomingMessages();
 
 		json incomingMessage;
 
 		// Check for invalid opcode and decode
-		websocketpp::lib::error_code errorCode;
 		uint8_t sessionEncoding = session->Encoding();
 		if (sessionEncoding == WebSocketEncoding::Json) {
 			if (opCode != websocketpp::frame::opcode::text) {
-				_server.close(hdl, WebSocketCloseCode::MessageDecodeError,
-					      "Your session encoding is set to Json, but a binary message was received.",
-					      errorCode);
+				CloseSession(session, hdl, WebSocketCloseCode::MessageDecodeError,
+					     "Your session encoding is set to Json, but a binary message was received.");
 				return;
 			}
 
 			try {
 				incomingMessage = json::parse(payload);
 			} catch (json::parse_error &e) {
-				_server.close(hdl, WebSocketCloseCode::MessageDecodeError,
-					      std::string("Unable to decode Json: ") + e.what(), errorCode);
+				CloseSession(session, hdl, WebSocketCloseCode::MessageDecodeError,
+					     std::string("Unable to decode Json: ") + e.what());
 				return;
 			}
 		} else if (sessionEncoding == WebSocketEncoding::MsgPack) {
 			if (opCode != websocketpp::frame::opcode::binary) {
-				_server.close(hdl, WebSocketCloseCode::MessageDecodeError,
-					      "Your session encoding is set to MsgPack, but a text message was received.",
-					      errorCode);
+				CloseSession(session, hdl, WebSocketCloseCode::MessageDecodeError,
+					     "Your session encoding is set to MsgPack, but a text message was received.");
 				return;
 			}
 
 			try {
 				incomingMessage = json::from_msgpack(payload);
 			} catch (json::parse_error &e) {
-				_server.close(hdl, WebSocketCloseCode::MessageDecodeError,
-					      std::string("Unable to decode MsgPack: ") + e.what(), errorCode);
+				CloseSession(session, hdl, WebSocketCloseCode::MessageDecodeError,
+					     std::string("Unable to decode MsgPack: ") + e.what());
 				return;
 			}
 		}
 
-		blog_debug("[WebSocketServer::onMessage] Incoming message (decoded):\n%s", incomingMessage.dump(2).c_str());
+		blog_debug("[WebSocketServer::HandleMessage] Incoming message (decoded):\n%s", incomingMessage.dump(2).c_str());
 
 		ProcessResult ret;
 
@@ -431,7 +747,7 @@ void WebSocketServer::onMessage(websocketpp::connection_hdl hdl,
 
 		// Disconnect client if 4.x protocol is detected
 		if (!session->IsIdentified() && incomingMessage.contains("request-type")) {
-			blog(LOG_WARNING, "[WebSocketServer::onMessage] Client %s appears to be running a pre-5.0.0 protocol.",
+			blog(LOG_WARNING, "[WebSocketServer::HandleMessage] Client %s appears to be running a pre-5.0.0 protocol.",
 			     session->RemoteAddress().c_str());
 			ret.closeCode = WebSocketCloseCode::UnsupportedRpcVersion;
 			ret.closeReason =
@@ -452,32 +768,26 @@ void WebSocketServer::onMessage(websocketpp::connection_hdl hdl,
 			goto skipProcessing;
 		}
 
-		ProcessMessage(session, ret, incomingMessage["op"], incomingMessage["d"]);
+		ProcessMessage(session, ret, incomingMessage["op"], incomingMessage["d"], receivedAt);
 
 	skipProcessing:
 		if (ret.closeCode != WebSocketCloseCode::DontClose) {
-			websocketpp::lib::error_code errorCode;
-			_server.close(hdl, ret.closeCode, ret.closeReason, errorCode);
+			CloseSession(session, hdl, ret.closeCode, ret.closeReason);
 			return;
 		}
 
 		if (!ret.result.is_null()) {
-			websocketpp::lib::error_code errorCode;
-			if (sessionEncoding == WebSocketEncoding::Json) {
-				std::string helloMessageJson = ret.result.dump();
-				_server.send(hdl, helloMessageJson, websocketpp::frame::opcode::text, errorCode);
-			} else if (sessionEncoding == WebSocketEncoding::MsgPack) {
-				auto msgPackData = json::to_msgpack(ret.result);
-				std::string messageMsgPack(msgPackData.begin(), msgPackData.end());
-				_server.send(hdl, messageMsgPack, websocketpp::frame::opcode::binary, errorCode);
-			}
-			session->IncrementOutgoingMessages();
+			// Stamped as late as possible, as the client uses it to estimate the clock offset
+			if (ret.result["op"] == WebSocketOpCode::ClockSyncResponse)
+				ret.result["d"]["serverSentAt"] = os_gettime_ns();
+
+			websocketpp::lib::error_code errorCode = SendMessage(session, hdl, SerializeMessage(ret.result, sessionEncoding));
 
-			blog_debug("[WebSocketServer::onMessage] Outgoing message:\n%s", ret.result.dump(2).c_str());
+			blog_debug("[WebSocketServer::HandleMessage] Outgoing message:\n%s", ret.result.dump(2).c_str());
 
 			if (errorCode)
-				blog(LOG_WARNING, "[WebSocketServer::onMessage] Sending message to client failed: %s",
+				blog(LOG_WARNING, "[WebSocketServer::HandleMessage] Sending message to client failed: %s",
 				     errorCode.message().c_str());
 		}
-	}));
+	});
 }
@@ -19,18 +19,28 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
+#include <vector>
 #include <QObject>
 #include <QThreadPool>
 #include <QString>
 #include <asio.hpp>
-#include <websocketpp/config/asio_no_tls.hpp>
 #include <websocketpp/server.hpp>
 
+#include "WebSocketServerConfig.h"
+#include "LocalConnection.h"
+#include "EventRing.h"
+#include "EventFilter.h"
+#include "EventRateLimit.h"
+#include "EventReplayBuffer.h"
 #include "rpc/WebSocketSession.h"
 #include "types/WebSocketCloseCode.h"
 #include "types/WebSocketOpCode.h"
 #include "../utils/Json.h"
+#include "../utils/Threading.h"
 #include "../requesthandler/rpc/Request.h"
 #include "../plugin-macros.generated.h"
 
@@ -39,6 +49,8 @@ class WebSocketServer : QObject {
 
 public:
 	enum WebSocketEncoding { Json, MsgPack };
+	// What to do with low priority (high-volume) messages when a client's outbound queue is over the high-water mark
+	enum SlowConsumerPolicy { Drop, Coalesce, Close };
 
 	struct WebSocketSessionState {
 		websocketpp::connection_hdl hdl;
@@ -47,6 +59,15 @@ public:
 		uint64_t incomingMessages;
 		uint64_t outgoingMessages;
 		bool isIdentified;
+		uint64_t outboundQueueBytes;
+		uint64_t droppedMessages;
+	};
+
+	struct EventDispatcherStats {
+		uint64_t queueDepth;
+		uint64_t dispatchedEvents;
+		uint64_t lastDrainLatency; // Nanoseconds between the oldest event of the last batch being queued and the batch being sent
+		uint64_t maxDrainLatency;
 	};
 
 	WebSocketServer();
@@ -55,12 +76,13 @@ public:
 	void Start();
 	void Stop();
 	void InvalidateSession(websocketpp::connection_hdl hdl);
-	void BroadcastEvent(uint64_t requiredIntent, const std::string &eventType, const json &eventData = nullptr,
-			    uint8_t rpcVersion = 0);
+	void ClearSuspendedSessions();
+	void BroadcastEvent(std::shared_ptr<Event> event);
 
 	bool IsListening() { return _server.is_listening(); }
 
 	std::vector<WebSocketSessionState> GetWebSocketSessions();
+	EventDispatcherStats GetEventDispatcherStats();
 
 	QThreadPool *GetThreadPool() { return &_threadPool; }
 
@@ -75,25 +97,126 @@ private:
 		json result;
 	};
 
+	// Immutable snapshot of identified sessions, laid out as parallel arrays so that event fan-out can filter in a
+	// tight loop. A new table is published whenever a session identifies, reidentifies, or disconnects.
+	struct SubscriberTable {
+		std::vector<websocketpp::connection_hdl> hdls;
+		std::vector<SessionPtr> sessions;
+		std::vector<uint64_t> eventSubscriptions;
+		std::vector<uint8_t> encodings;
+		std::vector<uint8_t> rpcVersions;
+		std::vector<asio::ip::udp::endpoint> udpEndpoints; // Port is zero if the session has no UDP side channel
+		std::vector<EventRateLimitTablePtr> rateLimits; // Null if the session has no rate limits
+		std::vector<EventFilterPtr> filters;            // Null if the session has no event filter
+		std::vector<bool> eventTimestamps;
+	};
+	typedef std::shared_ptr<const SubscriberTable> SubscriberTablePtr;
+
+	// State of an identified session which disconnected, kept for the resume grace period. Its subscription refs are
+	// only released once `expiry` fires, so a quick reconnect does not tear down and rebuild event handlers.
+	struct SuspendedSession {
+		uint64_t eventSubscriptions;
+		uint8_t rpcVersion;
+		uint16_t udpPort;
+		EventRateLimitTable rateLimitOverrides;
+		EventFilterPtr filter;
+		bool eventTimestamps;
+		std::unique_ptr<asio::steady_timer> expiry;
+	};
+
+	struct QueuedEvent {
+		std::shared_ptr<Event> event; // Not stamped with a sequence number yet
+		uint64_t queuedAt;
+	};
+
 	void ServerRunner();
 
+	websocketpp::lib::error_code SendToConnection(SessionPtr session, websocketpp::connection_hdl hdl, MessagePtr message);
+	websocketpp::lib::error_code CloseSession(SessionPtr session, websocketpp::connection_hdl hdl, uint16_t closeCode,
+						  const std::string &closeReason);
+	websocketpp::lib::error_code GetBufferedAmount(SessionPtr session, websocketpp::connection_hdl hdl,
+						       size_t &bufferedAmount);
+
+	static MessagePtr SerializeMessage(const json &message, uint8_t encoding);
+	websocketpp::lib::error_code SendMessage(SessionPtr session, websocketpp::connection_hdl hdl, MessagePtr message,
+						 bool lowPriority = false, const std::string &coalesceKey = "");
+	bool FlushPendingMessages(SessionPtr session, websocketpp::connection_hdl hdl);
+	bool FlushAllPendingMessages();
+	uint64_t FlushAllThrottledEvents();
+
+	void PublishSubscriberTable();
+	void StartEventDispatcher();
+	void StopEventDispatcher();
+	void EventDispatcherRunner();
+	void DispatchEvents(std::vector<QueuedEvent> &events);
+	void ReplayEvents(const SubscriberTablePtr &subscribers);
+	void SendEvent(SessionPtr session, websocketpp::connection_hdl hdl, const asio::ip::udp::endpoint &udpEndpoint,
+		       const WebSocketSession::OutgoingEvent &event);
+	bool SendDatagram(SessionPtr session, const asio::ip::udp::endpoint &endpoint, const std::string &payload);
+
 	void onObsLoaded();
 	bool onValidate(websocketpp::connection_hdl hdl);
 	void onOpen(websocketpp::connection_hdl hdl);
 	void onClose(websocketpp::connection_hdl hdl);
-	void onMessage(websocketpp::connection_hdl hdl, websocketpp::server<websocketpp::config::asio>::message_ptr message);
-
-	static void SetSessionParameters(SessionPtr session, WebSocketServer::ProcessResult &ret, const json &payloadData);
-	void ProcessMessage(SessionPtr session, ProcessResult &ret, WebSocketOpCode::WebSocketOpCode opCode, json &payloadData);
+	void onMessage(SessionPtr session, websocketpp::connection_hdl hdl,
+		       websocketpp::server<WebSocketServerConfig>::message_ptr message);
+
+	void AddSession(SessionPtr session, websocketpp::connection_hdl hdl);
+	bool SuspendSession(SessionPtr session, uint16_t closeCode);
+	bool ResumeSession(const std::string &resumeToken, SuspendedSession &state);
+	void ExpireSuspendedSession(const std::string &resumeToken);
+	void RemoveSession(websocketpp::connection_hdl hdl, uint16_t closeCode, const std::string &closeReason);
+	void HandleMessage(SessionPtr session, websocketpp::connection_hdl hdl, websocketpp::frame::opcode::value opCode,
+			   std::string payload);
+
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+	void StartLocalListener();
+	void StopLocalListener();
+	void AcceptLocalConnection();
+	void onLocalOpen(LocalConnectionPtr connection);
+#endif
+
+	void SetSessionParameters(SessionPtr session, WebSocketServer::ProcessResult &ret, const json &payloadData);
+	void ProcessMessage(SessionPtr session, ProcessResult &ret, WebSocketOpCode::WebSocketOpCode opCode, json &payloadData,
+			    uint64_t receivedAt);
 
 	QThreadPool _threadPool;
 
-	std::thread _serverThread;
-	websocketpp::server<websocketpp::config::asio> _server;
+	std::vector<std::thread> _serverThreads;
+	websocketpp::server<WebSocketServerConfig> _server;
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+	std::unique_ptr<asio::local::stream_protocol::acceptor> _localAcceptor;
+	// Serializes the accept handler with closing the acceptor, as the IO threads share one io_context
+	std::unique_ptr<asio::strand<asio::local::stream_protocol::acceptor::executor_type>> _localStrand;
+	std::string _localSocketPath;
+#endif
 
 	std::string _authenticationSecret;
 	std::string _authenticationSalt;
 
 	std::mutex _sessionMutex;
 	std::map<websocketpp::connection_hdl, SessionPtr, std::owner_less<websocketpp::connection_hdl>> _sessions;
+	SubscriberTablePtr _subscribers; // Only access with std::atomic_load/std::atomic_store
+	EventRateLimitTablePtr _globalEventRateLimits; // Only access with std::atomic_load/std::atomic_store
+	std::mutex _suspendedSessionsMutex;
+	std::map<std::string, SuspendedSession> _suspendedSessions; // Keyed by resume token
+
+	Utils::Threading::MpscQueue<QueuedEvent> _eventQueue;
+	EventRing _eventRing; // Only touched by the dispatcher, or while it is stopped
+	uint64_t _eventRingSubscriptions;
+	EventReplayBuffer _eventReplayBuffer;
+	bool _eventReplayEnabled; // Records the events generated for subscribed sessions, without subscribing itself
+	uint64_t _eventSequence; // Only touched by the dispatcher, or while it is stopped
+	std::atomic<bool> _eventReplayRequested;
+	std::unique_ptr<asio::ip::udp::socket> _udpSocket; // Only touched by the dispatcher, or while it is stopped
+	bool _udpSocketIsV6;
+	size_t _udpMaxDatagramSize;
+	std::thread _eventDispatcherThread;
+	std::mutex _eventDispatcherMutex;
+	std::condition_variable _eventDispatcherCondition;
+	std::atomic<bool> _eventDispatcherRunning;
+	std::atomic<uint64_t> _eventQueueDepth;
+	std::atomic<uint64_t> _dispatchedEvents;
+	std::atomic<uint64_t> _lastEventDrainLatency;
+	std::atomic<uint64_t> _maxEventDrainLatency;
 };
@@ -0,0 +1,64 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <websocketpp/config/asio_no_tls.hpp>
+
+#include "PerMessageDeflate.h"
+
+// Extra state on every websocketpp connection, filled in during the handshake
+struct WebSocketConnectionData {
+	bool compression = false; // Whether permessage-deflate was negotiated
+};
+
+// Stock websocketpp asio config, with permessage-deflate support and connection data added
+struct WebSocketServerConfig : public websocketpp::config::asio {
+	typedef WebSocketServerConfig type;
+	typedef websocketpp::config::asio base;
+
+	typedef base::concurrency_type concurrency_type;
+
+	typedef base::request_type request_type;
+	typedef base::response_type response_type;
+
+	typedef base::message_type message_type;
+	typedef base::con_msg_manager_type con_msg_manager_type;
+	typedef base::endpoint_msg_manager_type endpoint_msg_manager_type;
+
+	typedef base::alog_type alog_type;
+	typedef base::elog_type elog_type;
+
+	typedef base::rng_type rng_type;
+
+	struct transport_config : public base::transport_config {
+		typedef type::concurrency_type concurrency_type;
+		typedef type::alog_type alog_type;
+		typedef type::elog_type elog_type;
+		typedef type::request_type request_type;
+		typedef type::response_type response_type;
+		typedef websocketpp::transport::asio::basic_socket::endpoint socket_type;
+	};
+
+	typedef websocketpp::transport::asio::endpoint<transport_config> transport_type;
+
+	typedef PerMessageDeflate permessage_deflate_type;
+
+	typedef WebSocketConnectionData connection_base;
+};
@@ -0,0 +1,465 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <array>
+#include <obs-module.h>
+
+#include "WebSocketServer.h"
+#include "../eventhandler/EventHandler.h"
+#include "../eventhandler/types/EventSubscription.h"
+#include "../obs-websocket.h"
+#include "../Config.h"
+
+// Rebuilds the subscriber snapshot from the session map. Building and storing under the session lock guarantees that
+// the most recently stored table always reflects the latest session state.
+void WebSocketServer::PublishSubscriberTable()
+{
+	auto subscribers = std::make_shared<SubscriberTable>();
+
+	std::unique_lock<std::mutex> lock(_sessionMutex);
+	for (auto &[hdl, session] : _sessions) {
+		if (!session->IsIdentified())
+			continue;
+
+		subscribers->hdls.push_back(hdl);
+		subscribers->sessions.push_back(session);
+		subscribers->eventSubscriptions.push_back(session->EventSubscriptions());
+		subscribers->encodings.push_back(session->Encoding());
+		subscribers->rpcVersions.push_back(session->RpcVersion());
+		subscribers->udpEndpoints.emplace_back(session->RemoteIp(), session->UdpPort());
+		subscribers->rateLimits.push_back(session->RateLimits());
+		subscribers->filters.push_back(session->Filter());
+		subscribers->eventTimestamps.push_back(session->EventTimestamps());
+	}
+	std::atomic_store(&_subscribers, SubscriberTablePtr(subscribers));
+}
+
+void WebSocketServer::StartEventDispatcher()
+{
+	std::vector<QueuedEvent> staleEvents;
+	_eventQueueDepth -= _eventQueue.PopAll(staleEvents);
+	_lastEventDrainLatency = 0;
+	_maxEventDrainLatency = 0;
+
+	// Global rate limits apply to sessions which identify from now on
+	auto conf = GetConfig();
+	auto globalRateLimits = std::make_shared<EventRateLimitTable>();
+	if (conf && !conf->EventRateLimits.isEmpty()) {
+		std::string errorMessage;
+		json rateLimitsJson = json::parse(conf->EventRateLimits.toStdString(), nullptr, false);
+		if (!ParseEventRateLimits(rateLimitsJson, *globalRateLimits, errorMessage))
+			blog(LOG_WARNING, "[WebSocketServer::StartEventDispatcher] Ignoring invalid event rate limits: %s",
+			     errorMessage.c_str());
+	}
+	std::atomic_store(&_globalEventRateLimits, EventRateLimitTablePtr(globalRateLimits));
+
+	// The ring counts as a subscriber of its own, so its events are generated even when no client wants them
+	if (conf && !conf->EventRingName.isEmpty() &&
+	    _eventRing.Open(conf->EventRingName.toStdString(), conf->EventRingSize)) {
+		_eventRingSubscriptions = conf->EventRingSubscriptions;
+		GetEventHandler()->ProcessSubscription(_eventRingSubscriptions);
+	}
+
+	// Unlike the ring, the replay buffer does not subscribe. It only keeps events which were generated for sessions, so
+	// it does not keep signals connected or events generated while no client wants them.
+	uint64_t replayBufferSize = conf ? conf->EventReplayBufferSize.load() : 0;
+	_eventReplayBuffer.Reset(replayBufferSize, _eventSequence);
+	_eventReplayEnabled = replayBufferSize != 0;
+
+	// Sent to synchronously from the dispatcher, so it never needs the io_context to run
+	if (conf && conf->UdpEventsEnabled) {
+		asio::error_code errorCode;
+		auto protocol = conf->Ipv4Only ? asio::ip::udp::v4() : asio::ip::udp::v6();
+		_udpSocket = std::make_unique<asio::ip::udp::socket>(_server.get_io_service());
+		_udpSocket->open(protocol, errorCode);
+		if (!errorCode && protocol == asio::ip::udp::v6())
+			_udpSocket->set_option(asio::ip::v6_only(false), errorCode);
+		if (!errorCode)
+			_udpSocket->non_blocking(true, errorCode);
+		if (errorCode) {
+			blog(LOG_ERROR, "[WebSocketServer::StartEventDispatcher] Unable to open UDP socket: %s",
+			     errorCode.message().c_str());
+			_udpSocket.reset();
+		}
+		_udpSocketIsV6 = protocol == asio::ip::udp::v6();
+		_udpMaxDatagramSize = conf->UdpMaxDatagramSize;
+	}
+
+	_eventDispatcherRunning = true;
+	_eventDispatcherThread = std::thread(&WebSocketServer::EventDispatcherRunner, this);
+}
+
+void WebSocketServer::StopEventDispatcher()
+{
+	if (!_eventDispatcherThread.joinable())
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(_eventDispatcherMutex);
+		_eventDispatcherRunning = false;
+	}
+	_eventDispatcherCondition.notify_one();
+	_eventDispatcherThread.join();
+
+	std::vector<QueuedEvent> staleEvents;
+	_eventQueueDepth -= _eventQueue.PopAll(staleEvents);
+
+	_udpSocket.reset();
+
+	if (_eventRing.IsOpen()) {
+		GetEventHandler()->ProcessUnsubscription(_eventRingSubscriptions);
+		_eventRing.Close();
+		_eventRingSubscriptions = 0;
+	}
+
+	// Events sent while stopped can't be replayed
+	_eventReplayBuffer.Reset(0, _eventSequence);
+	_eventReplayEnabled = false;
+}
+
+WebSocketServer::EventDispatcherStats WebSocketServer::GetEventDispatcherStats()
+{
+	EventDispatcherStats ret;
+	ret.queueDepth = _eventQueueDepth.load();
+	ret.dispatchedEvents = _dispatchedEvents.load();
+	ret.lastDrainLatency = _lastEventDrainLatency.load();
+	ret.maxDrainLatency = _maxEventDrainLatency.load();
+	return ret;
+}
+
+// It isn't consistent to directly call the WebSocketServer from the events system, but it would also be dumb to make it unnecessarily complicated.
+// Events are only queued here. The dispatcher thread sends them in the same order that they were emitted.
+void WebSocketServer::BroadcastEvent(std::shared_ptr<Event> event)
+{
+	if (!_server.is_listening())
+		return;
+
+	_eventQueueDepth++;
+	bool wasEmpty = _eventQueue.Push(QueuedEvent{std::move(event), os_gettime_ns()});
+
+	// Only an empty queue can have a sleeping dispatcher
+	if (wasEmpty) {
+		std::unique_lock<std::mutex> lock(_eventDispatcherMutex);
+		_eventDispatcherCondition.notify_one();
+	}
+}
+
+void WebSocketServer::EventDispatcherRunner()
+{
+	blog_debug("[WebSocketServer::EventDispatcherRunner] Event dispatcher thread started.");
+
+	std::vector<QueuedEvent> events;
+	while (_eventDispatcherRunning) {
+		_eventQueue.PopAll(events);
+		if (events.empty()) {
+			// Coalesced messages must go out once their client catches up, and throttled events once they are due,
+			// even if no new event arrives
+			if (_eventReplayRequested.exchange(false))
+				ReplayEvents(std::atomic_load(&_subscribers));
+			bool pendingMessages = FlushAllPendingMessages();
+			uint64_t nextThrottledAt = FlushAllThrottledEvents();
+
+			std::unique_lock<std::mutex> lock(_eventDispatcherMutex);
+			auto predicate = [this] {
+				return !_eventDispatcherRunning || !_eventQueue.Empty() || _eventReplayRequested;
+			};
+			std::chrono::nanoseconds timeout = std::chrono::milliseconds(50);
+			if (nextThrottledAt) {
+				uint64_t now = os_gettime_ns();
+				std::chrono::nanoseconds untilDue(nextThrottledAt > now ? nextThrottledAt - now : 0);
+				if (!pendingMessages || untilDue < timeout)
+					timeout = untilDue;
+			}
+			if (pendingMessages || nextThrottledAt)
+				_eventDispatcherCondition.wait_for(lock, timeout, predicate);
+			else
+				_eventDispatcherCondition.wait(lock, predicate);
+			continue;
+		}
+
+		DispatchEvents(events);
+		FlushAllThrottledEvents();
+
+		uint64_t drainLatency = os_gettime_ns() - events.front().queuedAt;
+		_lastEventDrainLatency = drainLatency;
+		if (drainLatency > _maxEventDrainLatency)
+			_maxEventDrainLatency = drainLatency;
+		_dispatchedEvents += events.size();
+		_eventQueueDepth -= events.size();
+
+		events.clear();
+	}
+
+	blog_debug("[WebSocketServer::EventDispatcherRunner] Event dispatcher thread exited.");
+}
+
+// Returns true if any subscriber still has pending messages
+bool WebSocketServer::FlushAllPendingMessages()
+{
+	SubscriberTablePtr subscribers = std::atomic_load(&_subscribers);
+	size_t subscriberCount = subscribers->hdls.size();
+
+	bool ret = false;
+	for (size_t i = 0; i < subscriberCount; i++) {
+		if (!subscribers->sessions[i]->HasPendingMessages())
+			continue;
+		if (FlushPendingMessages(subscribers->sessions[i], subscribers->hdls[i]))
+			ret = true;
+	}
+	return ret;
+}
+
+// Sends every throttled event which is due. Returns when the next one is due, or 0 if none are left.
+uint64_t WebSocketServer::FlushAllThrottledEvents()
+{
+	SubscriberTablePtr subscribers = std::atomic_load(&_subscribers);
+	size_t subscriberCount = subscribers->hdls.size();
+
+	uint64_t now = os_gettime_ns();
+	uint64_t ret = 0;
+	for (size_t i = 0; i < subscriberCount; i++) {
+		if (!subscribers->sessions[i]->HasThrottledEvents())
+			continue;
+
+		uint64_t nextDueAt;
+		for (auto &event : subscribers->sessions[i]->TakeDueEvents(now, nextDueAt)) {
+			// Held back events are only serialized now, so replaced ones never were
+			bool withTimestamps = subscribers->eventTimestamps[i];
+			event.message = event.event->GetSerializedMessage(subscribers->encodings[i], SerializeMessage, withTimestamps);
+			if (event.lowPriority && subscribers->udpEndpoints[i].port())
+				event.datagram =
+					event.event->GetSerializedMessage(WebSocketEncoding::MsgPack, SerializeMessage, withTimestamps);
+			SendEvent(subscribers->sessions[i], subscribers->hdls[i], subscribers->udpEndpoints[i], event);
+		}
+		if (nextDueAt && (!ret || nextDueAt < ret))
+			ret = nextDueAt;
+	}
+	return ret;
+}
+
+// Builds the key which newer copies of a low priority event replace older ones by, eg. one transform per scene item
+static std::string GetCoalesceKey(const std::string &eventType, const json &eventData)
+{
+	std::string ret = eventType;
+	if (!eventData.is_object())
+		return ret;
+
+	for (auto field : {"sceneName", "sceneItemId", "inputName"}) {
+		auto it = eventData.find(field);
+		if (it == eventData.end())
+			continue;
+		ret += '\n';
+		ret += it->is_string() ? it->get<std::string>() : it->dump();
+	}
+	return ret;
+}
+
+// Sends a batch of events in order. Recipients come from the lock-free subscriber snapshot.
+void WebSocketServer::DispatchEvents(std::vector<QueuedEvent> &events)
+{
+	SubscriberTablePtr subscribers = std::atomic_load(&_subscribers);
+	size_t subscriberCount = subscribers->hdls.size();
+
+	// Sessions which just identified get the events they missed before any of these
+	ReplayEvents(subscribers);
+
+	for (auto &queuedEvent : events) {
+		// Events are numbered in the order they are dispatched, before anything is serialized
+		uint64_t now = os_gettime_ns();
+		queuedEvent.event->SetSequence(++_eventSequence);
+		queuedEvent.event->SetDispatchTimes(queuedEvent.queuedAt, now);
+
+		// The envelope already holds the complete message. It only serializes each encoding when its needed, and then
+		// shares the framed message between all recipients and any rate limited session which holds on to it.
+		EventPtr event = std::move(queuedEvent.event);
+		bool lowPriority = EventSubscription::IsHighVolume(event->RequiredIntent());
+		std::string coalesceKey;
+		if (lowPriority)
+			coalesceKey = GetCoalesceKey(event->EventType(), event->EventData());
+
+		for (size_t i = 0; i < subscriberCount; i++) {
+			if ((subscribers->eventSubscriptions[i] & event->RequiredIntent()) == 0)
+				continue;
+			if (event->RpcVersion() && subscribers->rpcVersions[i] != event->RpcVersion())
+				continue;
+
+			// Filters are applied before anything is serialized for the session. Volume meters are narrowed down to the
+			// session's inputs, so they get an envelope of their own.
+			EventPtr sessionEvent = event;
+			const EventFilterPtr &filter = subscribers->filters[i];
+			if (filter) {
+				if (!filter->Matches(event->EventType(), event->EventData()))
+					continue;
+				if (filter->FiltersInputs(event->EventType(), event->EventData())) {
+					json filteredEventData;
+					if (!filter->FilterInputs(event->EventData(), filteredEventData))
+						continue;
+					sessionEvent = event->WithEventData(std::move(filteredEventData));
+				}
+			}
+
+			WebSocketSession::OutgoingEvent outgoingEvent;
+			outgoingEvent.lowPriority = lowPriority;
+			outgoingEvent.coalesceKey = coalesceKey;
+
+			// Rate limits are applied before anything is serialized for the session
+			if (subscribers->rateLimits[i]) {
+				auto rateLimit = subscribers->rateLimits[i]->find(event->EventType());
+				if (rateLimit != subscribers->rateLimits[i]->end()) {
+					outgoingEvent.event = sessionEvent;
+					std::string rateLimitKey = rateLimit->second.GetKey(event->EventType(), event->EventData());
+					if (!subscribers->sessions[i]->ThrottleEvent(rateLimitKey, now, rateLimit->second, outgoingEvent))
+						continue;
+					outgoingEvent.event.reset();
+				}
+			}
+
+			// High-volume events go over the session's UDP side channel when it has one, unless they do not fit
+			bool withTimestamps = subscribers->eventTimestamps[i];
+			if (lowPriority && subscribers->udpEndpoints[i].port())
+				outgoingEvent.datagram =
+					sessionEvent->GetSerializedMessage(WebSocketEncoding::MsgPack, SerializeMessage, withTimestamps);
+
+			outgoingEvent.message =
+				sessionEvent->GetSerializedMessage(subscribers->encodings[i], SerializeMessage, withTimestamps);
+
+			SendEvent(subscribers->sessions[i], subscribers->hdls[i], subscribers->udpEndpoints[i], outgoingEvent);
+		}
+
+		// The ring gets the same Json message that WebSocket clients receive
+		if ((_eventRingSubscriptions & event->RequiredIntent()) != 0 &&
+		    (!event->RpcVersion() || event->RpcVersion() == OBS_WEBSOCKET_RPC_VERSION)) {
+			MessagePtr messageJson = event->GetSerializedMessage(WebSocketEncoding::Json, SerializeMessage);
+			if (!_eventRing.Write(messageJson->get_payload()))
+				blog(LOG_WARNING, "[WebSocketServer::DispatchEvents] Event `%s` is too large for the event ring.",
+				     event->EventType().c_str());
+		}
+
+		// Recorded after sending, so a session in the next snapshot gets it replayed if it asked for it. High volume
+		// events are stale by the time a client reconnects, so they are not kept.
+		if (_eventReplayEnabled && !lowPriority) {
+			size_t size = event->GetSerializedMessage(WebSocketEncoding::Json, SerializeMessage)->get_payload().size();
+			_eventReplayBuffer.Push(event->Sequence(), event, size);
+		} else {
+			_eventReplayBuffer.Push(event->Sequence(), nullptr, 0);
+		}
+
+		if (IsDebugEnabled() && (EventSubscription::All & event->RequiredIntent()) != 0) // Don't log high volume events
+			blog(LOG_INFO, "[WebSocketServer::DispatchEvents] Outgoing event:\n%s", event->Message().dump(2).c_str());
+	}
+}
+
+// Sends the events that sessions identifying with a `lastSequence` missed. Only the dispatcher replays, so no new event
+// can overtake the replayed ones.
+void WebSocketServer::ReplayEvents(const SubscriberTablePtr &subscribers)
+{
+	size_t subscriberCount = subscribers->hdls.size();
+	for (size_t i = 0; i < subscriberCount; i++) {
+		uint64_t lastSequence;
+		if (!subscribers->sessions[i]->HasPendingReplay() || !subscribers->sessions[i]->TakePendingReplay(lastSequence))
+			continue;
+
+		// The buffer may have rolled over since `Identify` checked it. The session stays open, but has to resync.
+		std::vector<EventPtr> events;
+		if (!_eventReplayBuffer.GetEventsAfter(lastSequence, events)) {
+			json message;
+			message["op"] = WebSocketOpCode::EventReplayUnavailable;
+			message["d"]["lastSequence"] = lastSequence;
+			message["d"]["resyncRequired"] = true;
+			websocketpp::lib::error_code errorCode = SendMessage(subscribers->sessions[i], subscribers->hdls[i],
+									     SerializeMessage(message, subscribers->encodings[i]));
+			if (errorCode && errorCode != websocketpp::error::bad_connection &&
+			    errorCode != websocketpp::error::invalid_state)
+				blog(LOG_ERROR, "[WebSocketServer::ReplayEvents] Error sending resync message: %s",
+				     errorCode.message().c_str());
+			continue;
+		}
+
+		for (auto &event : events) {
+			if ((subscribers->eventSubscriptions[i] & event->RequiredIntent()) == 0)
+				continue;
+			if (event->RpcVersion() && subscribers->rpcVersions[i] != event->RpcVersion())
+				continue;
+			if (subscribers->filters[i] && !subscribers->filters[i]->Matches(event->EventType(), event->EventData()))
+				continue;
+
+			WebSocketSession::OutgoingEvent outgoingEvent;
+			outgoingEvent.message = event->GetSerializedMessage(subscribers->encodings[i], SerializeMessage,
+									    subscribers->eventTimestamps[i]);
+			SendEvent(subscribers->sessions[i], subscribers->hdls[i], subscribers->udpEndpoints[i], outgoingEvent);
+		}
+	}
+}
+
+void WebSocketServer::SendEvent(SessionPtr session, websocketpp::connection_hdl hdl,
+				const asio::ip::udp::endpoint &udpEndpoint, const WebSocketSession::OutgoingEvent &event)
+{
+	if (event.datagram && SendDatagram(session, udpEndpoint, event.datagram->get_payload()))
+		return;
+
+	// Coalesced events are older than this one, so they go first
+	if (session->HasPendingMessages())
+		FlushPendingMessages(session, hdl);
+
+	websocketpp::lib::error_code errorCode = SendMessage(session, hdl, event.message, event.lowPriority, event.coalesceKey);
+
+	// The snapshot can briefly contain a connection which has just closed
+	if (errorCode == websocketpp::error::bad_connection || errorCode == websocketpp::error::invalid_state)
+		return;
+	if (errorCode)
+		blog(LOG_ERROR, "[WebSocketServer::SendEvent] Error sending event message: %s", errorCode.message().c_str());
+}
+
+// Datagram layout: "OW" magic, u8 version, u8 encoding (always MsgPack), u64 big endian per-session sequence number,
+// then the same Event message that would have been sent over WebSocket. Returns false if the caller should fall back
+// to the WebSocket connection.
+bool WebSocketServer::SendDatagram(SessionPtr session, const asio::ip::udp::endpoint &endpoint, const std::string &payload)
+{
+	std::array<uint8_t, 12> header;
+	if (!_udpSocket || header.size() + payload.size() > _udpMaxDatagramSize)
+		return false;
+
+	uint64_t sequence = session->NextUdpSequence();
+	header[0] = 'O';
+	header[1] = 'W';
+	header[2] = 1;
+	header[3] = WebSocketEncoding::MsgPack;
+	for (size_t i = 0; i < 8; i++)
+		header[4 + i] = (uint8_t)(sequence >> (56 - i * 8));
+
+	// The TCP acceptor reports IPv4 clients as mapped addresses on dual stack sockets, and the other way around
+	asio::ip::udp::endpoint destination = endpoint;
+	if (_udpSocketIsV6 && endpoint.address().is_v4())
+		destination.address(asio::ip::make_address_v6(asio::ip::v4_mapped, endpoint.address().to_v4()));
+	else if (!_udpSocketIsV6 && endpoint.address().is_v6() && endpoint.address().to_v6().is_v4_mapped())
+		destination.address(asio::ip::make_address_v4(asio::ip::v4_mapped, endpoint.address().to_v6()));
+
+	std::array<asio::const_buffer, 2> buffers = {asio::buffer(header), asio::buffer(payload)};
+	asio::error_code errorCode;
+	_udpSocket->send_to(buffers, destination, 0, errorCode);
+
+	// A full send buffer drops the datagram, which is fine for data that is stale by the next update anyway
+	if (errorCode && errorCode != asio::error::would_block) {
+		blog_debug("[WebSocketServer::SendDatagram] Sending datagram failed: %s", errorCode.message().c_str());
+		return false;
+	}
+
+	session->IncrementOutgoingMessages();
+	return true;
+}
@@ -0,0 +1,141 @@
+/*
+obs-websocket
+Copyright (C) 2016-2021 Stephane Lepin <stephane.lepin@gmail.com>
+Copyright (C) 2020-2021 Kyle Manning <tt2468@gmail.com>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <filesystem>
+#include <future>
+#include <obs-module.h>
+
+#include "WebSocketServer.h"
+#include "../obs-websocket.h"
+#include "../Config.h"
+
+#ifdef ASIO_HAS_LOCAL_SOCKETS
+
+// The local listener shares the WebSocket server's io_context, so it is served by the same IO threads
+void WebSocketServer::StartLocalListener()
+{
+	_localAcceptor.reset();
+	_localStrand.reset();
+	_localSocketPath.clear();
+
+	auto conf = GetConfig();
+	if (!conf || conf->LocalSocketPath.isEmpty())
+		return;
+
+	std::string localSocketPath = conf->LocalSocketPath.toStdString();
+
+	// A socket file left behind by a crash would make bind() fail. Anything else at that path is left alone.
+	std::error_code fileError;
+	if (std::filesystem::is_socket(localSocketPath, fileError))
+		std::filesystem::remove(localSocketPath, fileError);
+
+	asio::error_code errorCode;
+	auto acceptor = std::make_unique<asio::local::stream_protocol::acceptor>(_server.get_io_service());
+	acceptor->open(asio::local::stream_protocol(), errorCode);
+	if (!errorCode)
+		acceptor->bind(asio::local::stream_protocol::endpoint(localSocketPath), errorCode);
+	if (errorCode) {
+		blog(LOG_ERROR, "[WebSocketServer::StartLocalListener] Unable to bind local socket `%s`: %s", localSocketPath.c_str(),
+		     errorCode.message().c_str());
+		return;
+	}
+
+	// Permissions are applied before listening, so nobody can connect while the socket still has the default mode
+	std::filesystem::permissions(localSocketPath, (std::filesystem::perms)conf->LocalSocketPermissions.load(), fileError);
+	if (fileError) {
+		blog(LOG_ERROR, "[WebSocketServer::StartLocalListener] Unable to set permissions of local socket `%s`: %s",
+		     localSocketPath.c_str(), fileError.message().c_str());
+		std::filesystem::remove(localSocketPath, fileError);
+		return;
+	}
+
+	acceptor->listen(asio::socket_base::max_listen_connections, errorCode);
+	if (errorCode) {
+		blog(LOG_ERROR, "[WebSocketServer::StartLocalListener] Unable to listen on local socket `%s`: %s",
+		     localSocketPath.c_str(), errorCode.message().c_str());
+		std::filesystem::remove(localSocketPath, fileError);
+		return;
+	}
+
+	_localSocketPath = localSocketPath;
+	_localStrand = std::make_unique<asio::strand<asio::local::stream_protocol::acceptor::executor_type>>(
+		asio::make_strand(acceptor->get_executor()));
+	_localAcceptor = std::move(acceptor);
+	AcceptLocalConnection();
+
+	blog(LOG_INFO, "[WebSocketServer::StartLocalListener] Listening on local socket `%s`", _localSocketPath.c_str());
+}
+
+// The acceptor itself is only destroyed by the next StartLocalListener(), once no IO thread can still be using it
+void WebSocketServer::StopLocalListener()
+{
+	if (!_localAcceptor)
+		return;
+
+	// An accept handler may be running on an IO thread, so the acceptor is closed on the strand and waited for
+	std::promise<void> closed;
+	asio::post(*_localStrand, [this, &closed]() {
+		asio::error_code errorCode;
+		_localAcceptor->close(errorCode);
+		closed.set_value();
+	});
+	closed.get_future().wait();
+
+	std::error_code fileError;
+	std::filesystem::remove(_localSocketPath, fileError);
+}
+
+void WebSocketServer::AcceptLocalConnection()
+{
+	_localAcceptor->async_accept(asio::bind_executor(
+		*_localStrand, [this](const asio::error_code &errorCode, asio::local::stream_protocol::socket socket) {
+			if (errorCode == asio::error::operation_aborted)
+				return;
+
+			if (errorCode)
+				blog(LOG_WARNING, "[WebSocketServer::AcceptLocalConnection] Accept failed: %s",
+				     errorCode.message().c_str());
+			else
+				onLocalOpen(std::make_shared<LocalConnection>(std::move(socket)));
+
+			if (_localAcceptor->is_open())
+				AcceptLocalConnection();
+		}));
+}
+
+void WebSocketServer::onLocalOpen(LocalConnectionPtr connection)
+{
+	// There is no handshake to pick a subprotocol or negotiate compression with, so local sessions always use Json
+	SessionPtr session = std::make_shared<WebSocketSession>();
+	session->SetIsLocal(true);
+	session->SetRemoteAddress("unix:" + _localSocketPath);
+	session->SetEncoding(WebSocketEncoding::Json);
+
+	AddSession(session, connection);
+
+	connection->Start(
+		[this, session](LocalConnectionPtr connection, websocketpp::frame::opcode::value opCode, std::string payload) {
+			HandleMessage(session, connection, opCode, std::move(payload));
+		},
+		[this](LocalConnectionPtr connection) {
+			RemoveSession(connection, connection->CloseCode(), connection->CloseReason());
+		});
+}
+
+#endif
@@ -28,7 +28,6 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include "../Config.h"
 #include "../utils/Crypto.h"
 #include "../utils/Platform.h"
-#include "../utils/Compat.h"
 
 static bool IsSupportedRpcVersion(uint8_t requestedVersion)
 {
@@ -55,20 +54,99 @@ static json ConstructRequestResult(RequestResult requestResult, const json &requ
 	return ret;
 }
 
+// Every field is validated before any of them is applied, so a rejected payload leaves the session as it was
 void WebSocketServer::SetSessionParameters(SessionPtr session, ProcessResult &ret, const json &payloadData)
 {
-	if (payloadData.contains("eventSubscriptions")) {
-		if (!payloadData["eventSubscriptions"].is_number_unsigned()) {
+	if (payloadData.contains("eventSubscriptions") && !payloadData["eventSubscriptions"].is_number_unsigned()) {
+		ret.closeCode = WebSocketCloseCode::InvalidDataFieldType;
+		ret.closeReason = "Your `eventSubscriptions` is not an unsigned number.";
+		return;
+	}
+
+	// Session overrides are kept across `Reidentify`, and always merged over the current global limits
+	EventRateLimitTable rateLimitOverrides = session->RateLimitOverrides();
+
+	if (payloadData.contains("sceneItemTransformInterval")) {
+		if (!payloadData["sceneItemTransformInterval"].is_number_unsigned()) {
 			ret.closeCode = WebSocketCloseCode::InvalidDataFieldType;
-			ret.closeReason = "Your `eventSubscriptions` is not an unsigned number.";
+			ret.closeReason = "Your `sceneItemTransformInterval` is not an unsigned number.";
 			return;
 		}
+		if (payloadData["sceneItemTransformInterval"].get<uint64_t>() > 60000) {
+			ret.closeCode = WebSocketCloseCode::InvalidDataFieldValue;
+			ret.closeReason = "Your `sceneItemTransformInterval` is larger than 60000.";
+			return;
+		}
+		// Shorthand for a `SceneItemTransformChanged` rate limit coalesced per scene item
+		EventRateLimit limit;
+		limit.minInterval = payloadData["sceneItemTransformInterval"];
+		limit.coalesceBy = {"sceneName", "sceneItemId"};
+		if (limit.minInterval)
+			rateLimitOverrides["SceneItemTransformChanged"] = limit;
+		else
+			rateLimitOverrides.erase("SceneItemTransformChanged");
+	}
+
+	if (payloadData.contains("eventRateLimits")) {
+		std::string errorMessage;
+		if (!ParseEventRateLimits(payloadData["eventRateLimits"], rateLimitOverrides, errorMessage)) {
+			ret.closeCode = WebSocketCloseCode::InvalidDataFieldValue;
+			ret.closeReason = "Your `eventRateLimits` is invalid: " + errorMessage;
+			return;
+		}
+	}
+
+	EventFilterPtr filter;
+	if (payloadData.contains("eventFilter") && !payloadData["eventFilter"].is_null()) {
+		auto parsedFilter = std::make_shared<EventFilter>();
+		std::string errorMessage;
+		if (!ParseEventFilter(payloadData["eventFilter"], *parsedFilter, errorMessage)) {
+			ret.closeCode = WebSocketCloseCode::InvalidDataFieldValue;
+			ret.closeReason = "Your `eventFilter` is invalid: " + errorMessage;
+			return;
+		}
+		if (!parsedFilter->IsEmpty())
+			filter = parsedFilter;
+	}
+
+	if (payloadData.contains("eventTimestamps") && !payloadData["eventTimestamps"].is_boolean()) {
+		ret.closeCode = WebSocketCloseCode::InvalidDataFieldType;
+		ret.closeReason = "Your `eventTimestamps` is not a boolean.";
+		return;
+	}
+
+	if (payloadData.contains("udpPort") &&
+	    (!payloadData["udpPort"].is_number_unsigned() || payloadData["udpPort"].get<uint64_t>() > 65535)) {
+		ret.closeCode = WebSocketCloseCode::InvalidDataFieldType;
+		ret.closeReason = "Your `udpPort` is not a valid port number.";
+		return;
+	}
+
+	if (payloadData.contains("eventSubscriptions"))
 		session->SetEventSubscriptions(payloadData["eventSubscriptions"]);
+
+	EventRateLimitTablePtr globalRateLimits = std::atomic_load(&_globalEventRateLimits);
+	auto rateLimits = std::make_shared<EventRateLimitTable>(*globalRateLimits);
+	for (auto &[eventType, limit] : rateLimitOverrides)
+		(*rateLimits)[eventType] = limit;
+	session->SetRateLimits(std::move(rateLimitOverrides), rateLimits->empty() ? nullptr : EventRateLimitTablePtr(rateLimits));
+
+	if (payloadData.contains("eventFilter"))
+		session->SetFilter(filter);
+
+	if (payloadData.contains("eventTimestamps"))
+		session->SetEventTimestamps(payloadData["eventTimestamps"]);
+
+	if (payloadData.contains("udpPort")) {
+		// Silently declined if disabled. Local sessions have no address to send datagrams to.
+		auto conf = GetConfig();
+		bool udpAvailable = conf && conf->UdpEventsEnabled && !session->IsLocal();
+		session->SetUdpPort(udpAvailable ? payloadData["udpPort"].get<uint16_t>() : 0);
 	}
 }
 
 void WebSocketServer::ProcessMessage(SessionPtr session, WebSocketServer::ProcessResult &ret,
-				     WebSocketOpCode::WebSocketOpCode opCode, json &payloadData)
+				     WebSocketOpCode::WebSocketOpCode opCode, json &payloadData, uint64_t receivedAt)
 {
 	if (!payloadData.is_object()) {
 		if (payloadData.is_null()) {
@@ -97,7 +175,32 @@ void WebSocketServer::ProcessMessage(SessionPtr session, WebSocketServer::Proces
 			return;
 		}
 
-		if (session->AuthenticationRequired()) {
+		if (payloadData.contains("resumeToken") && !payloadData["resumeToken"].is_string()) {
+			ret.closeCode = WebSocketCloseCode::InvalidDataFieldType;
+			ret.closeReason = "Your `resumeToken` is not a string.";
+			return;
+		}
+
+		// A valid resume token stands in for authentication. Otherwise this is a regular `Identify`.
+		SuspendedSession suspendedSession;
+		bool resumed = payloadData.contains("resumeToken") && ResumeSession(payloadData["resumeToken"], suspendedSession);
+		if (resumed) {
+			session->SetRpcVersion(suspendedSession.rpcVersion);
+			session->SetEventSubscriptions(suspendedSession.eventSubscriptions);
+			session->SetUdpPort(session->IsLocal() ? 0 : suspendedSession.udpPort);
+			session->SetRateLimits(std::move(suspendedSession.rateLimitOverrides), nullptr);
+			session->SetFilter(suspendedSession.filter);
+			session->SetEventTimestamps(suspendedSession.eventTimestamps);
+		}
+
+		// The resumed session's refs are only released once the new ones are held, so nothing shared is torn down
+		auto eventHandler = GetEventHandler();
+		auto releaseResumedSubscriptions = [&]() {
+			if (resumed)
+				eventHandler->ProcessUnsubscription(suspendedSession.eventSubscriptions);
+		};
+
+		if (!resumed && session->AuthenticationRequired()) {
 			if (!payloadData.contains("authentication")) {
 				ret.closeCode = WebSocketCloseCode::AuthenticationFailed;
 				ret.closeReason =
@@ -120,37 +223,67 @@ void WebSocketServer::ProcessMessage(SessionPtr session, WebSocketServer::Proces
 			}
 		}
 
-		if (!payloadData.contains("rpcVersion")) {
+		// A resumed session keeps its previous RPC version unless it asks for another one
+		if (!resumed && !payloadData.contains("rpcVersion")) {
 			ret.closeCode = WebSocketCloseCode::MissingDataField;
 			ret.closeReason = "Your payload's data is missing an `rpcVersion`.";
+			releaseResumedSubscriptions();
 			return;
 		}
 
-		if (!payloadData["rpcVersion"].is_number_unsigned()) {
-			ret.closeCode = WebSocketCloseCode::InvalidDataFieldType;
-			ret.closeReason = "Your `rpcVersion` is not an unsigned number.";
-			return;
+		if (payloadData.contains("rpcVersion")) {
+			if (!payloadData["rpcVersion"].is_number_unsigned()) {
+				ret.closeCode = WebSocketCloseCode::InvalidDataFieldType;
+				ret.closeReason = "Your `rpcVersion` is not an unsigned number.";
+				releaseResumedSubscriptions();
+				return;
+			}
+
+			uint8_t requestedRpcVersion = payloadData["rpcVersion"];
+			if (!IsSupportedRpcVersion(requestedRpcVersion)) {
+				ret.closeCode = WebSocketCloseCode::UnsupportedRpcVersion;
+				ret.closeReason = "Your requested RPC version is not supported by this server.";
+				releaseResumedSubscriptions();
+				return;
+			}
+			session->SetRpcVersion(requestedRpcVersion);
 		}
 
-		uint8_t requestedRpcVersion = payloadData["rpcVersion"];
-		if (!IsSupportedRpcVersion(requestedRpcVersion)) {
-			ret.closeCode = WebSocketCloseCode::UnsupportedRpcVersion;
-			ret.closeReason = "Your requested RPC version is not supported by this server.";
+		if (payloadData.contains("lastSequence") && !payloadData["lastSequence"].is_number_unsigned()) {
+			ret.closeCode = WebSocketCloseCode::InvalidDataFieldType;
+			ret.closeReason = "Your `lastSequence` is not an unsigned number.";
+			releaseResumedSubscriptions();
 			return;
 		}
-		session->SetRpcVersion(requestedRpcVersion);
 
 		SetSessionParameters(session, ret, payloadData);
 		if (ret.closeCode != WebSocketCloseCode::DontClose) {
+			releaseResumedSubscriptions();
 			return;
 		}
 
+		// Missed events are replayed by the dispatcher, once the session is in its subscriber snapshot
+		bool resyncRequired = false;
+		if (payloadData.contains("lastSequence")) {
+			uint64_t lastSequence = payloadData["lastSequence"];
+			resyncRequired = !_eventReplayBuffer.Covers(lastSequence);
+			if (!resyncRequired)
+				session->SetPendingReplay(lastSequence);
+		}
+
 		// Increment refs for event subscriptions
-		auto eventHandler = GetEventHandler();
 		eventHandler->ProcessSubscription(session->EventSubscriptions());
+		releaseResumedSubscriptions();
 
 		// Mark session as identified
 		session->SetIsIdentified(true);
+		PublishSubscriberTable();
+
+		if (session->HasPendingReplay()) {
+			std::unique_lock<std::mutex> lock(_eventDispatcherMutex);
+			_eventReplayRequested = true;
+			_eventDispatcherCondition.notify_one();
+		}
 
 		// Send desktop notification. TODO: Move to UI code
 		auto conf = GetConfig();
@@ -163,25 +296,40 @@ void WebSocketServer::ProcessMessage(SessionPtr session, WebSocketServer::Proces
 
 		ret.result["op"] = WebSocketOpCode::Identified;
 		ret.result["d"]["negotiatedRpcVersion"] = session->RpcVersion();
+		if (session->UdpPort())
+			ret.result["d"]["negotiatedUdpPort"] = session->UdpPort();
+		if (payloadData.contains("lastSequence"))
+			ret.result["d"]["resyncRequired"] = resyncRequired;
+		if (payloadData.contains("resumeToken"))
+			ret.result["d"]["resumed"] = resumed;
+		if (conf && conf->SessionResumeGracePeriod) {
+			// Single use, so a new one is issued on every `Identify`
+			std::string resumeToken = Utils::Crypto::GenerateSalt();
+			session->SetResumeToken(resumeToken);
+			ret.result["d"]["resumeToken"] = resumeToken;
+		}
 	}
 		return;
 	case WebSocketOpCode::Reidentify: { // Reidentify
 		std::unique_lock<std::mutex> sessionLock(session->OperationMutex);
 
-		// Decrement refs for current subscriptions
-		auto eventHandler = GetEventHandler();
-		eventHandler->ProcessUnsubscription(session->EventSubscriptions());
-
+		// The session keeps its current subscriptions if the payload is rejected
+		uint64_t previousSubscriptions = session->EventSubscriptions();
 		SetSessionParameters(session, ret, payloadData);
 		if (ret.closeCode != WebSocketCloseCode::DontClose) {
 			return;
 		}
 
-		// Increment refs for new subscriptions
+		// Increment refs for new subscriptions before decrementing the current ones, so shared ones are not torn down
+		auto eventHandler = GetEventHandler();
 		eventHandler->ProcessSubscription(session->EventSubscriptions());
+		eventHandler->ProcessUnsubscription(previousSubscriptions);
+		PublishSubscriberTable();
 
 		ret.result["op"] = WebSocketOpCode::Identified;
 		ret.result["d"]["negotiatedRpcVersion"] = session->RpcVersion();
+		if (session->UdpPort())
+			ret.result["d"]["negotiatedUdpPort"] = session->UdpPort();
 	}
 		return;
 	case WebSocketOpCode::Request: { // Request
@@ -326,70 +474,18 @@ void WebSocketServer::ProcessMessage(SessionPtr session, WebSocketServer::Proces
 		ret.result["d"]["results"] = results;
 	}
 		return;
+	case WebSocketOpCode::ClockSync: { // ClockSync
+		// Both times are on the monotonic clock that `eventTimestamps` use. The client's own time is echoed back as is.
+		// `serverSentAt` is filled in by HandleMessage right before the response is sent.
+		ret.result["op"] = WebSocketOpCode::ClockSyncResponse;
+		if (payloadData.contains("clientTime"))
+			ret.result["d"]["clientTime"] = payloadData["clientTime"];
+		ret.result["d"]["serverReceivedAt"] = receivedAt;
+	}
+		return;
 	default:
 		ret.closeCode = WebSocketCloseCode::UnknownOpCode;
 		ret.closeReason = std::string("Unknown OpCode: ") + std::to_string(opCode);
 		return;
 	}
 }
-
-// It isn't consistent to directly call the WebSocketServer from the events system, but it would also be dumb to make it unnecessarily complicated.
-void WebSocketServer::BroadcastEvent(uint64_t requiredIntent, const std::string &eventType, const json &eventData,
-				     uint8_t rpcVersion)
-{
-	if (!_server.is_listening())
-		return;
-
-	_threadPool.start(Utils::Compat::CreateFunctionRunnable([=]() {
-		// Populate message object
-		json eventMessage;
-		eventMessage["op"] = 5;
-		eventMessage["d"]["eventType"] = eventType;
-		eventMessage["d"]["eventIntent"] = requiredIntent;
-		if (eventData.is_object())
-			eventMessage["d"]["eventData"] = eventData;
-
-		// Initialize objects. The broadcast process only dumps the data when its needed.
-		std::string messageJson;
-		std::string messageMsgPack;
-
-		// Recurse connected sessions and send the event to suitable sessions.
-		std::unique_lock<std::mutex> lock(_sessionMutex);
-		for (auto &it : _sessions) {
-			if (!it.second->IsIdentified()) {
-				continue;
-			}
-			if (rpcVersion && it.second->RpcVersion() != rpcVersion) {
-				continue;
-			}
-			if ((it.second->EventSubscriptions() & requiredIntent) != 0) {
-				websocketpp::lib::error_code errorCode;
-				switch (it.second->Encoding()) {
-				case WebSocketEncoding::Json:
-					if (messageJson.empty()) {
-						messageJson = eventMessage.dump();
-					}
-					_server.send((websocketpp::connection_hdl)it.first, messageJson,
-						     websocketpp::frame::opcode::text, errorCode);
-					it.second->IncrementOutgoingMessages();
-					break;
-				case WebSocketEncoding::MsgPack:
-					if (messageMsgPack.empty()) {
-						auto msgPackData = json::to_msgpack(eventMessage);
-						messageMsgPack = std::string(msgPackData.begin(), msgPackData.end());
-					}
-					_server.send((websocketpp::connection_hdl)it.first, messageMsgPack,
-						     websocketpp::frame::opcode::binary, errorCode);
-					it.second->IncrementOutgoingMessages();
-					break;
-				}
-				if (errorCode)
-					blog(LOG_ERROR, "[WebSocketServer::BroadcastEvent] Error sending event message: %s",
-					     errorCode.message().c_str());
-			}
-		}
-		lock.unlock();
-		if (IsDebugEnabled() && (EventSubscription::All & requiredIntent) != 0) // Don't log high volume events
-			blog(LOG_INFO, "[WebSocketServer::BroadcastEvent] Outgoing event:\n%s", eventMessage.dump(2).c_str());
-	}));
-}
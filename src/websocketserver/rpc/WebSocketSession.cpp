@@ -17,16 +17,29 @@ You should have received a copy of the GNU General Public License along
 with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
+#include <algorithm>
+
 #include "WebSocketSession.h"
 #include "../../eventhandler/types/EventSubscription.h"
 
 WebSocketSession::WebSocketSession()
 	: _remoteAddress(""),
+	  _udpPort(0),
+	  _udpSequence(0),
 	  _connectedAt(0),
 	  _incomingMessages(0),
 	  _outgoingMessages(0),
+	  _droppedMessages(0),
+	  _hasPendingMessages(false),
+	  _eventTimestamps(false),
+	  _hasThrottledEvents(false),
+	  _hasPendingReplay(false),
+	  _replayLastSequence(0),
 	  _encoding(0),
+	  _compression(false),
+	  _isLocal(false),
 	  _challenge(""),
+	  _resumeToken(""),
 	  _rpcVersion(OBS_WEBSOCKET_RPC_VERSION),
 	  _isIdentified(false),
 	  _eventSubscriptions(EventSubscription::All)
@@ -46,6 +59,33 @@ void WebSocketSession::SetRemoteAddress(std::string address)
 	_remoteAddress = address;
 }
 
+asio::ip::address WebSocketSession::RemoteIp()
+{
+	std::lock_guard<std::mutex> lock(_remoteAddressMutex);
+	return _remoteIp;
+}
+
+void WebSocketSession::SetRemoteIp(asio::ip::address ip)
+{
+	std::lock_guard<std::mutex> lock(_remoteAddressMutex);
+	_remoteIp = ip;
+}
+
+uint16_t WebSocketSession::UdpPort()
+{
+	return _udpPort.load();
+}
+
+void WebSocketSession::SetUdpPort(uint16_t port)
+{
+	_udpPort.store(port);
+}
+
+uint64_t WebSocketSession::NextUdpSequence()
+{
+	return ++_udpSequence;
+}
+
 uint64_t WebSocketSession::ConnectedAt()
 {
 	return _connectedAt.load();
@@ -76,6 +116,163 @@ void WebSocketSession::IncrementOutgoingMessages()
 	_outgoingMessages++;
 }
 
+uint64_t WebSocketSession::DroppedMessages()
+{
+	return _droppedMessages.load();
+}
+
+void WebSocketSession::IncrementDroppedMessages()
+{
+	_droppedMessages++;
+}
+
+void WebSocketSession::SetPendingMessage(const std::string &key, MessagePtr message)
+{
+	std::lock_guard<std::mutex> lock(_pendingMessagesMutex);
+	auto it = _pendingMessages.find(key);
+	if (it != _pendingMessages.end()) {
+		// The replaced message is never sent
+		it->second = std::move(message);
+		_droppedMessages++;
+	} else {
+		_pendingMessages.emplace(key, std::move(message));
+	}
+	_hasPendingMessages.store(true);
+}
+
+bool WebSocketSession::HasPendingMessages()
+{
+	return _hasPendingMessages.load();
+}
+
+std::vector<MessagePtr> WebSocketSession::TakePendingMessages()
+{
+	std::vector<MessagePtr> ret;
+	std::lock_guard<std::mutex> lock(_pendingMessagesMutex);
+	for (auto &[key, message] : _pendingMessages)
+		ret.push_back(std::move(message));
+	_pendingMessages.clear();
+	_hasPendingMessages.store(false);
+	return ret;
+}
+
+EventRateLimitTable WebSocketSession::RateLimitOverrides()
+{
+	std::lock_guard<std::mutex> lock(_rateLimitsMutex);
+	return _rateLimitOverrides;
+}
+
+EventRateLimitTablePtr WebSocketSession::RateLimits()
+{
+	std::lock_guard<std::mutex> lock(_rateLimitsMutex);
+	return _rateLimits;
+}
+
+void WebSocketSession::SetRateLimits(EventRateLimitTable overrides, EventRateLimitTablePtr rateLimits)
+{
+	std::lock_guard<std::mutex> lock(_rateLimitsMutex);
+	_rateLimitOverrides = std::move(overrides);
+	_rateLimits = std::move(rateLimits);
+}
+
+EventFilterPtr WebSocketSession::Filter()
+{
+	std::lock_guard<std::mutex> lock(_filterMutex);
+	return _filter;
+}
+
+void WebSocketSession::SetFilter(EventFilterPtr filter)
+{
+	std::lock_guard<std::mutex> lock(_filterMutex);
+	_filter = std::move(filter);
+}
+
+bool WebSocketSession::EventTimestamps()
+{
+	return _eventTimestamps.load();
+}
+
+void WebSocketSession::SetEventTimestamps(bool enabled)
+{
+	_eventTimestamps.store(enabled);
+}
+
+bool WebSocketSession::ThrottleEvent(const std::string &key, uint64_t now, const EventRateLimit &limit,
+				     const OutgoingEvent &event)
+{
+	std::lock_guard<std::mutex> lock(_throttleMutex);
+	auto &state = _throttleStates[key];
+	state.interval = limit.minInterval * 1000000ULL;
+	state.tolerance = (limit.burst - 1) * state.interval;
+	if (!state.pending.event && now + state.tolerance >= state.allowedAt) {
+		state.allowedAt = std::max(state.allowedAt, now) + state.interval;
+		return true;
+	}
+
+	// The replaced event is never sent
+	if (state.pending.event)
+		_droppedMessages++;
+	state.pending = event;
+	_hasThrottledEvents.store(true);
+	return false;
+}
+
+bool WebSocketSession::HasThrottledEvents()
+{
+	return _hasThrottledEvents.load();
+}
+
+std::vector<WebSocketSession::OutgoingEvent> WebSocketSession::TakeDueEvents(uint64_t now, uint64_t &nextDueAt)
+{
+	std::vector<OutgoingEvent> ret;
+	nextDueAt = 0;
+
+	std::lock_guard<std::mutex> lock(_throttleMutex);
+	for (auto it = _throttleStates.begin(); it != _throttleStates.end();) {
+		auto &state = it->second;
+		if (!state.pending.event) {
+			// The whole burst is available again, so the state is no different from a fresh one
+			if (now >= state.allowedAt)
+				it = _throttleStates.erase(it);
+			else
+				++it;
+			continue;
+		}
+
+		uint64_t dueAt = state.allowedAt > state.tolerance ? state.allowedAt - state.tolerance : 0;
+		if (now >= dueAt) {
+			ret.push_back(std::move(state.pending));
+			state.pending = OutgoingEvent();
+			state.allowedAt = std::max(state.allowedAt, now) + state.interval;
+		} else if (!nextDueAt || dueAt < nextDueAt) {
+			nextDueAt = dueAt;
+		}
+		++it;
+	}
+	_hasThrottledEvents.store(nextDueAt != 0);
+
+	return ret;
+}
+
+void WebSocketSession::SetPendingReplay(uint64_t lastSequence)
+{
+	_replayLastSequence = lastSequence;
+	_hasPendingReplay.store(true);
+}
+
+bool WebSocketSession::HasPendingReplay()
+{
+	return _hasPendingReplay.load();
+}
+
+bool WebSocketSession::TakePendingReplay(uint64_t &lastSequence)
+{
+	if (!_hasPendingReplay.exchange(false))
+		return false;
+	lastSequence = _replayLastSequence;
+	return true;
+}
+
 uint8_t WebSocketSession::Encoding()
 {
 	return _encoding.load();
@@ -86,6 +283,26 @@ void WebSocketSession::SetEncoding(uint8_t encoding)
 	_encoding.store(encoding);
 }
 
+bool WebSocketSession::Compression()
+{
+	return _compression.load();
+}
+
+void WebSocketSession::SetCompression(bool compression)
+{
+	_compression.store(compression);
+}
+
+bool WebSocketSession::IsLocal()
+{
+	return _isLocal.load();
+}
+
+void WebSocketSession::SetIsLocal(bool local)
+{
+	_isLocal.store(local);
+}
+
 bool WebSocketSession::AuthenticationRequired()
 {
 	return _authenticationRequired.load();
@@ -122,6 +339,19 @@ void WebSocketSession::SetChallenge(std::string challengeString)
 	_challenge = challengeString;
 }
 
+std::string WebSocketSession::ResumeToken()
+{
+	std::lock_guard<std::mutex> lock(_resumeTokenMutex);
+	std::string ret(_resumeToken);
+	return ret;
+}
+
+void WebSocketSession::SetResumeToken(std::string token)
+{
+	std::lock_guard<std::mutex> lock(_resumeTokenMutex);
+	_resumeToken = token;
+}
+
 uint8_t WebSocketSession::RpcVersion()
 {
 	return _rpcVersion.load();
@@ -151,3 +381,13 @@ void WebSocketSession::SetEventSubscriptions(uint64_t subscriptions)
 {
 	_eventSubscriptions.store(subscriptions);
 }
+
+Utils::Threading::SerialExecutorPtr WebSocketSession::Executor()
+{
+	return _executor;
+}
+
+void WebSocketSession::SetExecutor(Utils::Threading::SerialExecutorPtr executor)
+{
+	_executor = executor;
+}
@@ -23,7 +23,14 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <string>
 #include <atomic>
 #include <memory>
-
+#include <map>
+#include <vector>
+#include <websocketpp/config/asio_no_tls.hpp>
+
+#include "../EventFilter.h"
+#include "../EventRateLimit.h"
+#include "../../eventhandler/types/Event.h"
+#include "../../utils/Threading.h"
 #include "../../plugin-macros.generated.h"
 
 class WebSocketSession;
@@ -31,11 +38,29 @@ typedef std::shared_ptr<WebSocketSession> SessionPtr;
 
 class WebSocketSession {
 public:
+	// An event message for one session. `datagram` is only set if it may go over the UDP side channel. Events held back
+	// by a rate limit only carry `event`, and are serialized once they are actually sent.
+	struct OutgoingEvent {
+		MessagePtr message;
+		MessagePtr datagram;
+		EventPtr event;
+		bool lowPriority = false;
+		std::string coalesceKey;
+	};
+
 	WebSocketSession();
 
 	std::string RemoteAddress();
 	void SetRemoteAddress(std::string address);
 
+	asio::ip::address RemoteIp();
+	void SetRemoteIp(asio::ip::address ip);
+
+	// Non-zero once the client negotiated the UDP side channel for high-volume events
+	uint16_t UdpPort();
+	void SetUdpPort(uint16_t port);
+	uint64_t NextUdpSequence();
+
 	uint64_t ConnectedAt();
 	void SetConnectedAt(uint64_t at);
 
@@ -45,9 +70,49 @@ public:
 	uint64_t OutgoingMessages();
 	void IncrementOutgoingMessages();
 
+	uint64_t DroppedMessages();
+	void IncrementDroppedMessages();
+
+	// Replaces any pending message with the same key, so only the latest value is ever sent
+	void SetPendingMessage(const std::string &key, MessagePtr message);
+	bool HasPendingMessages();
+	std::vector<MessagePtr> TakePendingMessages();
+
+	// The session's overrides of the global event rate limits, and the limits in effect (global merged with overrides)
+	EventRateLimitTable RateLimitOverrides();
+	EventRateLimitTablePtr RateLimits();
+	void SetRateLimits(EventRateLimitTable overrides, EventRateLimitTablePtr rateLimits);
+
+	// Null if the session receives every event it is subscribed to
+	EventFilterPtr Filter();
+	void SetFilter(EventFilterPtr filter);
+
+	// Whether events are sent with their `eventTimestamps`
+	bool EventTimestamps();
+	void SetEventTimestamps(bool enabled);
+
+	// Returns true if an event for `key` may be sent now. Otherwise the event is kept until `limit` allows it,
+	// replacing any event already kept for the key.
+	bool ThrottleEvent(const std::string &key, uint64_t now, const EventRateLimit &limit, const OutgoingEvent &event);
+	bool HasThrottledEvents();
+	// Takes the kept events which are due. `nextDueAt` is set to when the next one is due, or 0 if none are left.
+	std::vector<OutgoingEvent> TakeDueEvents(uint64_t now, uint64_t &nextDueAt);
+
+	// Set while identifying with a `lastSequence`. The event dispatcher sends the missed events before any new one.
+	void SetPendingReplay(uint64_t lastSequence);
+	bool HasPendingReplay();
+	bool TakePendingReplay(uint64_t &lastSequence);
+
 	uint8_t Encoding();
 	void SetEncoding(uint8_t encoding);
 
+	bool Compression();
+	void SetCompression(bool compression);
+
+	// Connected over the local socket listener instead of WebSocket. Its connection_hdl is a LocalConnection.
+	bool IsLocal();
+	void SetIsLocal(bool local);
+
 	bool AuthenticationRequired();
 	void SetAuthenticationRequired(bool required);
 
@@ -57,6 +122,10 @@ public:
 	std::string Challenge();
 	void SetChallenge(std::string challenge);
 
+	// Issued in `Identified`. Presenting it in `Identify` shortly after disconnecting restores this session's state.
+	std::string ResumeToken();
+	void SetResumeToken(std::string token);
+
 	uint8_t RpcVersion();
 	void SetRpcVersion(uint8_t version);
 
@@ -66,21 +135,55 @@ public:
 	uint64_t EventSubscriptions();
 	void SetEventSubscriptions(uint64_t subscriptions);
 
+	Utils::Threading::SerialExecutorPtr Executor();
+	void SetExecutor(Utils::Threading::SerialExecutorPtr executor);
+
 	std::mutex OperationMutex;
 
 private:
 	std::mutex _remoteAddressMutex;
 	std::string _remoteAddress;
+	asio::ip::address _remoteIp;
+	std::atomic<uint16_t> _udpPort;
+	std::atomic<uint64_t> _udpSequence;
 	std::atomic<uint64_t> _connectedAt;
 	std::atomic<uint64_t> _incomingMessages;
 	std::atomic<uint64_t> _outgoingMessages;
+	std::atomic<uint64_t> _droppedMessages;
+	std::mutex _pendingMessagesMutex;
+	std::map<std::string, MessagePtr> _pendingMessages;
+	std::atomic<bool> _hasPendingMessages;
+	std::mutex _rateLimitsMutex;
+	EventRateLimitTable _rateLimitOverrides;
+	EventRateLimitTablePtr _rateLimits;
+	std::mutex _filterMutex;
+	EventFilterPtr _filter;
+	std::atomic<bool> _eventTimestamps;
+	// Generic cell rate algorithm: an event is allowed once `now >= allowedAt - tolerance`, and each one sent moves
+	// `allowedAt` one interval further. `tolerance` is (burst - 1) intervals.
+	struct ThrottleState {
+		uint64_t allowedAt = 0;
+		uint64_t interval = 0;
+		uint64_t tolerance = 0;
+		OutgoingEvent pending;
+	};
+	std::mutex _throttleMutex;
+	std::map<std::string, ThrottleState> _throttleStates;
+	std::atomic<bool> _hasThrottledEvents;
+	std::atomic<bool> _hasPendingReplay;
+	uint64_t _replayLastSequence;
 	std::atomic<uint8_t> _encoding;
+	std::atomic<bool> _compression;
+	std::atomic<bool> _isLocal;
 	std::atomic<bool> _authenticationRequired;
 	std::mutex _secretMutex;
 	std::string _secret;
 	std::mutex _challengeMutex;
 	std::string _challenge;
+	std::mutex _resumeTokenMutex;
+	std::string _resumeToken;
 	std::atomic<uint8_t> _rpcVersion;
 	std::atomic<bool> _isIdentified;
 	std::atomic<uint64_t> _eventSubscriptions;
+	Utils::Threading::SerialExecutorPtr _executor;
 };
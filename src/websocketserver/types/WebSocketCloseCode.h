@@ -168,5 +168,16 @@ namespace WebSocketCloseCode {
 		* @api enums
 		*/
 		UnsupportedFeature = 4012,
+		/**
+		* The client is not reading messages fast enough, and its outbound message queue exceeded the server's limit.
+		*
+		* @enumIdentifier SlowConsumer
+		* @enumValue 4013
+		* @enumType WebSocketCloseCode
+		* @rpcVersion -1
+		* @initialVersion 5.1.0
+		* @api enums
+		*/
+		SlowConsumer = 4013,
 	};
 }
@@ -120,7 +120,40 @@ namespace WebSocketOpCode {
 		* @api enums
 		*/
 		RequestBatchResponse = 9,
+		/**
+		* The message sent by a client to obs-websocket to estimate the offset between their clocks.
+		*
+		* @enumIdentifier ClockSync
+		* @enumValue 10
+		* @enumType WebSocketOpCode
+		* @rpcVersion -1
+		* @initialVersion 5.1.0
+		* @api enums
+		*/
+		ClockSync = 10,
+		/**
+		* The message sent by obs-websocket in response to a `ClockSync` from a client.
+		*
+		* @enumIdentifier ClockSyncResponse
+		* @enumValue 11
+		* @enumType WebSocketOpCode
+		* @rpcVersion -1
+		* @initialVersion 5.1.0
+		* @api enums
+		*/
+		ClockSyncResponse = 11,
+		/**
+		* The message sent by obs-websocket to an identified client when the events it missed could not be replayed.
+		*
+		* @enumIdentifier EventReplayUnavailable
+		* @enumValue 12
+		* @enumType WebSocketOpCode
+		* @rpcVersion -1
+		* @initialVersion 5.1.0
+		* @api enums
+		*/
+		EventReplayUnavailable = 12,
 	};
 
-	inline bool IsValid(uint8_t opCode) { return opCode >= Hello && opCode <= RequestBatchResponse; }
+	inline bool IsValid(uint8_t opCode) { return opCode >= Hello && opCode <= EventReplayUnavailable; }
 }